@@ -2,35 +2,344 @@
 #include<vector>
 #include<algorithm>
 #include <fstream>
+#include <sstream>
 #include<map>
+#include <unordered_map>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+#include <random>
+#include <cstdint>
+#include <cmath>
+#include <climits>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <poll.h>
+#include <csignal>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <immintrin.h>
 using namespace std;
 
+// with -DCOUNT_ALLOCATIONS every heap allocation of the program is counted so the alloc mode can report
+// allocations per iteration, the default build keeps the library allocator
+atomic<long long> allocation_count(0);
+
+#ifdef COUNT_ALLOCATIONS
+void *counted_malloc(size_t size) {
+    allocation_count.fetch_add(1, memory_order_relaxed);
+    void *p = malloc(size ? size : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+
+void *operator new(size_t size) {
+    return counted_malloc(size);
+}
+
+void *operator new[](size_t size) {
+    return counted_malloc(size);
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    free(p);
+}
+#endif
+
+// summary of many random partitions of one graph
+struct CutDistribution {
+    long long samples = 0;
+    double mean = 0, stddev = 0;
+    long long min = 0, max = 0;
+};
+
+// improvement phase used after the construction phase of GRASP
+enum ImprovementMode { LOCAL_SEARCH, TABU_SEARCH, TABU_SEARCH_2FLIP };
+
+// result of a time-budgeted GRASP run
+struct TimedGraspResult {
+    pair<vector<int>, vector<int>> best_sets;
+    long long best_cut = LLONG_MIN;
+    int iterations = 0;
+    double time_to_target = -1; // seconds, -1 if the target was never reached
+    double elapsed = 0;
+    vector<pair<double, long long>> trace; // (seconds, best cut so far) at every improvement
+};
+
+
+// result of reactive GRASP, the alpha selection probabilities adapt to the cuts each alpha produced
+struct ReactiveGraspResult {
+    TimedGraspResult run;
+    vector<double> alphas;
+    vector<double> probabilities; // final selection probability of every alpha
+    vector<int> uses;             // iterations constructed with every alpha
+    vector<pair<int, vector<double>>> history; // (iteration, probabilities) after every update
+};
+
+// partition packed one bit per vertex (0 = set1, 1 = set2) together with its cut weight and the
+// gain of moving every vertex to the other set, copying into an object of the same size reuses
+// its buffers so a GRASP worker can keep one around without allocating
+struct Solution {
+    vector<uint64_t> bits;
+    vector<long long> gain;
+    long long cut = 0;
+
+    void resize(int vertices) {
+        bits.assign(vertices / 64 + 1, 0);
+        gain.assign(vertices + 1, 0);
+        cut = 0;
+    }
+
+    int side(int v) const {
+        return (bits[v >> 6] >> (v & 63)) & 1;
+    }
+
+    void flip_bit(int v) {
+        bits[v >> 6] ^= 1ULL << (v & 63);
+    }
+
+    void copy_from(const Solution &other) {
+        bits.assign(other.bits.begin(), other.bits.end());
+        gain.assign(other.gain.begin(), other.gain.end());
+        cut = other.cut;
+    }
+};
+
+// buffers a GRASP worker reuses across iterations
+struct GraspWorkspace {
+    Solution current, relinked, best, tabu_best;
+    vector<long long> sigma1, sigma2, values;
+    vector<int> candidates, position, rcl, tabu_until, diff, flips;
+};
+
+// pool of diverse high quality partitions
+struct ElitePool {
+    int capacity;
+    int min_distance; // minimum number of differing vertices to another elite
+    int vertices;
+    vector<Solution> members;
+
+    ElitePool(int capacity, int min_distance, int vertices) : capacity(capacity), min_distance(min_distance), vertices(vertices) {
+        members.reserve(capacity);
+    }
+
+    // partitions are symmetric, so a partition and its complement are the same cut
+    int distance(const Solution &a, const Solution &b) const {
+        int diff = 0;
+        for (int i = 0; i < (int)a.bits.size(); i++) {
+            diff += __builtin_popcountll(a.bits[i] ^ b.bits[i]);
+        }
+        return min(diff, vertices - diff);
+    }
+
+    int worst_index() {
+        int worst = 0;
+        for (int i = 1; i < (int)members.size(); i++) {
+            if (members[i].cut < members[worst].cut) worst = i;
+        }
+        return worst;
+    }
+
+    bool try_add(const Solution &s) {
+        long long best = LLONG_MIN;
+        for (auto &m : members) best = max(best, m.cut);
+
+        // a new best solution is always accepted, otherwise it has to be diverse enough
+        for (auto &m : members) {
+            int d = distance(m, s);
+            if (d == 0 || (s.cut <= best && d < min_distance)) return false;
+        }
+
+        if ((int)members.size() < capacity) {
+            members.emplace_back();
+            members.back().copy_from(s);
+            return true;
+        }
+        int worst = worst_index();
+        if (s.cut <= members[worst].cut) return false;
+        members[worst].copy_from(s);
+        return true;
+    }
+};
+
+// --- row kernels for the adjacency matrix ---
+
+// sigma[i] += row[i] for i < n, AVX2 widens 4 weights at a time to 64 bits
+__attribute__((target("avx2"))) void add_row_avx2(long long *sigma, const int *row, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i w = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(row + i)));
+        __m256i s = _mm256_loadu_si256((const __m256i *)(sigma + i));
+        _mm256_storeu_si256((__m256i *)(sigma + i), _mm256_add_epi64(s, w));
+    }
+    for (; i < n; i++) sigma[i] += row[i];
+}
+
+void add_row_scalar(long long *sigma, const int *row, int n) {
+    for (int i = 0; i < n; i++) sigma[i] += row[i];
+}
+
+// largest of row[0..n-1], INT_MIN for an empty row
+__attribute__((target("avx2"))) int row_max_avx2(const int *row, int n) {
+    int i = 0;
+    __m256i best = _mm256_set1_epi32(INT_MIN);
+    for (; i + 8 <= n; i += 8) {
+        best = _mm256_max_epi32(best, _mm256_loadu_si256((const __m256i *)(row + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, best);
+    int m = INT_MIN;
+    for (int k = 0; k < 8; k++) m = max(m, lanes[k]);
+    for (; i < n; i++) m = max(m, row[i]);
+    return m;
+}
+
+int row_max_scalar(const int *row, int n) {
+    int m = INT_MIN;
+    for (int i = 0; i < n; i++) m = max(m, row[i]);
+    return m;
+}
+
+// the binary is built with plain g++, so the AVX2 versions are only called when the CPU has AVX2
+bool cpu_has_avx2() {
+    static bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+void add_row(long long *sigma, const int *row, int n) {
+    if (cpu_has_avx2()) add_row_avx2(sigma, row, n);
+    else add_row_scalar(sigma, row, n);
+}
+
+int row_max(const int *row, int n) {
+    return cpu_has_avx2() ? row_max_avx2(row, n) : row_max_scalar(row, n);
+}
+
+// how the greedy heuristics get the weight from a vertex to each set
+// scan: sums the matrix entries over the set for every query, the original O(V^3) method
+// sparse: keeps the sums up to date by adding the CSR row of every placed vertex
+// dense: keeps the sums up to date by adding the matrix row of every placed vertex with the row kernel
+enum SigmaKernel { KERNEL_AUTO, KERNEL_SCAN, KERNEL_SPARSE, KERNEL_DENSE };
+
+// density from which the automatic choice uses the dense kernel, on 800 vertex random graphs the
+// contiguous row adds only beat the CSR scatter at about 30% density, so every G-set graph is sparse
+const double DENSE_MIN_DENSITY = 0.3;
+
+// change of one edge for Graph::apply_edge_deltas, weight is the new weight of edge (u,v) and 0 removes it
+struct EdgeDelta {
+    int u, v, weight;
+};
+
+// one level of the multilevel hierarchy: vertex v of the finer graph is part of coarse vertex parent[v],
+// on the same side as the coarse vertex when flipped[v] is 0 and on the other side when it is 1
+struct CoarseLevel {
+    vector<int> parent;
+    vector<char> flipped;
+    long long clamped = 0; // coarse edges whose merged weight did not fit in an int
+};
+
+// result of a multilevel run
+struct MultilevelResult {
+    pair<vector<int>, vector<int>> best_sets;
+    long long best_cut = LLONG_MIN;
+    int levels = 0;
+    int coarsest_vertices = 0;
+    long long clamped_edges = 0; // over all levels, the coarse objective is off when this is not 0
+    int cycles = 0;
+    double coarsen_seconds = 0;
+    double elapsed = 0;
+    vector<pair<double, long long>> trace; // (seconds, best cut so far) at every improvement
+};
+
+// the adjacency matrix is only built up to this many vertices, the set based heuristics need it
+// but everything else works on the CSR arrays, so larger graphs never pay the V^2 memory
+const int MATRIX_MAX_VERTICES = 5000;
 
 class Graph{
     int vertices;
     int edges ;
-    vector<vector<int>> adj_list;
+    // adjacency in compressed sparse row form, the neighbors of v are
+    // adj[adj_start[v]] .. adj[adj_start[v+1]-1] with weights in adj_weight
+    vector<int> adj_start;
+    vector<int> adj;
+    vector<int> adj_weight;
+    // the edges as given in the file, one array per field
+    vector<int> edge_u, edge_v, edge_w;
     vector<vector<int>> adj_matrix;
+    mt19937 rng; // every graph has its own generator so graphs can be solved on separate threads
 
-    public:
-    Graph (int v, int e) : vertices(v), edges(e) {
-        adj_list.resize(vertices+1);
-        adj_matrix.resize(vertices+1, vector<int>(vertices+1, 0));
+    int random_int(int n) {
+        return rng() % n;
+    }
+
+    // CSR arrays (and the matrix when there is one) from the edge list
+    void build_adjacency() {
+        // counting sort of the edge endpoints, keeps the file order inside every row
+        adj_start.assign(vertices + 2, 0);
+        for (int j = 0; j < edges; j++) {
+            adj_start[edge_u[j] + 1]++;
+            adj_start[edge_v[j] + 1]++;
+        }
+        for (int i = 1; i <= vertices + 1; i++) adj_start[i] += adj_start[i - 1];
 
+        adj.resize(2 * edges);
+        adj_weight.resize(2 * edges);
+        vector<int> pos(adj_start.begin(), adj_start.end() - 1);
+        for (int j = 0; j < edges; j++) {
+            int u = edge_u[j], v = edge_v[j], w = edge_w[j];
+            adj[pos[u]] = v;
+            adj_weight[pos[u]++] = w;
+            adj[pos[v]] = u;
+            adj_weight[pos[v]++] = w;
+            if (!adj_matrix.empty()) {
+                adj_matrix[u][v] = w;
+                adj_matrix[v][u] = w;
+            }
+        }
+    }
 
+    public:
+    // with_matrix = false skips the adjacency matrix for graphs only the CSR kernels will see
+    Graph (int v, int e, const vector<int> &eu, const vector<int> &ev, const vector<int> &ew, bool with_matrix = true) : vertices(v), edges(e), edge_u(eu), edge_v(ev), edge_w(ew), rng(rand()) {
+        if (with_matrix && vertices <= MATRIX_MAX_VERTICES) adj_matrix.resize(vertices+1, vector<int>(vertices+1, 0));
+        build_adjacency();
     }
 
-    void add_edge(int u, int v, int w) {
-        adj_list[u].push_back(v);
-        adj_list[v].push_back(u);
-        adj_matrix[u][v] = w;
-        adj_matrix[v][u] = w;
+    // fixes the random stream so a run can be repeated
+    void seed(unsigned value) {
+        rng.seed(value);
     }
+
     void print_adj_list() {
         for (int i = 1; i <= vertices; i++) {
             cout << i << " -> ";
-            for (int j : adj_list[i]) {
-                cout << j << " ";
+            for (int k = adj_start[i]; k < adj_start[i + 1]; k++) {
+                cout << adj[k] << " ";
             }
             cout << endl;
         }
@@ -47,34 +356,16 @@ class Graph{
     // randomized heiuristic for Max cut
 
    double randomized_heuristic(int n ) {
-       vector<int> set1, set2;
+       vector<char> side(vertices + 1);
 
-       int total_cut_weight = 0;
+       long long total_cut_weight = 0;
        for (int k = 0; k < n; k++)
        {
-        set1.clear();
-        set2.clear();
            for (int i = 1; i <= vertices; i++)
            {
-               if (rand() % 2 == 0)
-               {
-                   set1.push_back(i);
-               }
-               else
-               {
-                   set2.push_back(i);
-               }
-           }
-            // finding cut weight
-           int cut_weight = 0;
-           for (int i = 0; i < set1.size(); i++)
-           {
-               for (int j = 0; j < set2.size(); j++)
-               {
-                   cut_weight += adj_matrix[set1[i]][set2[j]];
-               }
+               side[i] = random_int(2);
            }
-           total_cut_weight += cut_weight;
+           total_cut_weight += cut_weight_sides(side);
        }
 
        double avg_cut_weight = total_cut_weight*1.0 / n;
@@ -85,17 +376,114 @@ class Graph{
     }
 
 
-    int calculate_w(int vertex, vector<int>u){
-        int w = 0;
-        for (int i = 0; i < u.size(); i++)
+    // cut weights of 64 partitions at once, bit k of mask[v] is the side of v in partition k
+    // an edge is cut in exactly the partitions where mask[u] ^ mask[v] has a 1, these bits are
+    // summed per weight with bit-sliced counters (plane p holds bit p of the 64 counts)
+    void bit_parallel_cuts(const vector<uint64_t> &mask, long long cuts[64]) {
+        for (int k = 0; k < 64; k++) cuts[k] = 0;
+
+        vector<int> weights;
+        vector<int> weight_class(edges);
+        bool too_many_weights = false;
+        for (int j = 0; j < edges && !too_many_weights; j++) {
+            int c = find(weights.begin(), weights.end(), edge_w[j]) - weights.begin();
+            if (c == (int)weights.size()) {
+                // one set of counters per distinct weight, G-set graphs only have 1 and -1
+                if (weights.size() == 8) too_many_weights = true;
+                else weights.push_back(edge_w[j]);
+            }
+            weight_class[j] = c;
+        }
+
+        if (too_many_weights) {
+            // general weights: add the weight to every partition that cuts the edge
+            for (int j = 0; j < edges; j++) {
+                uint64_t x = mask[edge_u[j]] ^ mask[edge_v[j]];
+                while (x) {
+                    cuts[__builtin_ctzll(x)] += edge_w[j];
+                    x &= x - 1;
+                }
+            }
+            return;
+        }
+
+        vector<vector<uint64_t>> planes(weights.size(), vector<uint64_t>(32, 0));
+        for (int j = 0; j < edges; j++) {
+            uint64_t carry = mask[edge_u[j]] ^ mask[edge_v[j]];
+            uint64_t *plane = planes[weight_class[j]].data();
+            for (int p = 0; carry; p++) {
+                uint64_t next = plane[p] & carry;
+                plane[p] ^= carry;
+                carry = next;
+            }
+        }
+        for (int c = 0; c < (int)weights.size(); c++) {
+            for (int p = 0; p < 32; p++) {
+                uint64_t bits = planes[c][p];
+                while (bits) {
+                    cuts[__builtin_ctzll(bits)] += weights[c] * (1LL << p);
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+    // distribution of the cut weight over batches * 64 uniformly random partitions
+    CutDistribution randomized_distribution(int batches) {
+        CutDistribution dist;
+        vector<uint64_t> mask(vertices + 1);
+        long long cuts[64];
+        double sum = 0, sum_sq = 0;
+        dist.min = LLONG_MAX;
+        dist.max = LLONG_MIN;
+
+        for (int b = 0; b < batches; b++) {
+            for (int v = 1; v <= vertices; v++) {
+                mask[v] = ((uint64_t)rng() << 32) | rng();
+            }
+            bit_parallel_cuts(mask, cuts);
+            for (int k = 0; k < 64; k++) {
+                sum += cuts[k];
+                sum_sq += (double)cuts[k] * cuts[k];
+                dist.min = min(dist.min, cuts[k]);
+                dist.max = max(dist.max, cuts[k]);
+            }
+        }
+
+        dist.samples = 64LL * batches;
+        if (dist.samples > 0) {
+            dist.mean = sum / dist.samples;
+            dist.stddev = sqrt(max(0.0, sum_sq / dist.samples - dist.mean * dist.mean));
+        }
+        return dist;
+    }
+
+    long long calculate_w(int vertex, const vector<int> &u){
+        long long w = 0;
+        for (int i = 0; i < (int)u.size(); i++)
         {
             w += adj_matrix[vertex][u[i]];
         }
         return w;
 
     }
-    int calculate_cut_weight(vector<int> &set1, vector<int> &set2) {
-        int cut_weight = 0;
+    // cut weight over the edge list, O(E) instead of O(|set1| * |set2|)
+    // side[v] is 0 for set1 and 1 for set2, every cut edge has exactly one endpoint with side 1
+    long long cut_weight_sides(const vector<char> &side) {
+        long long cut_weight = 0;
+        for (int j = 0; j < edges; j++) {
+            cut_weight += (side[edge_u[j]] ^ side[edge_v[j]]) * (long long)edge_w[j];
+        }
+        return cut_weight;
+    }
+
+    long long calculate_cut_weight(vector<int> &set1, vector<int> &set2) {
+        return cut_weight_sides(to_sides(set1, set2));
+    }
+
+    // original set1 x set2 scan over the adjacency matrix, kept to check cut_weight_sides against
+    long long calculate_cut_weight_pairs(vector<int> &set1, vector<int> &set2) {
+        long long cut_weight = 0;
         for (int u : set1) {
             for (int v : set2) {
                 cut_weight += adj_matrix[u][v];
@@ -107,44 +495,111 @@ class Graph{
     
 
 
+    // heaviest edge of the graph, ties go to the smallest (u, v) like a scan of the upper triangle
+    // of the matrix would; false when no edge has a positive weight, since putting its ends on opposite
+    // sides would force a negative edge into the cut
+    bool heaviest_edge(int &max_u, int &max_v) {
+        if (edges == 0) return false;
+        long long max_weight = LLONG_MIN;
+        for (int j = 0; j < edges; j++) {
+            int u = min(edge_u[j], edge_v[j]), v = max(edge_u[j], edge_v[j]);
+            if (edge_w[j] > max_weight || (edge_w[j] == max_weight && make_pair(u, v) < make_pair(max_u, max_v))) {
+                max_weight = edge_w[j];
+                max_u = u;
+                max_v = v;
+            }
+        }
+        return max_weight > 0;
+    }
+
     // greedy heuristic for Max cut
-    double greedy_heuristic() {
-        vector<int> set1, set2;
-       
-        vector<bool> visited(vertices + 1, false);
-    
-        //Finding the maximum edge
-        int max_u = -1, max_v = -1, max_weight = -1;
-        for (int u = 1; u <= vertices; u++) {
-            for (int v = u + 1; v <= vertices; v++) {
-                if (adj_matrix[u][v] > max_weight) {
-                    max_weight = adj_matrix[u][v];
+    double density() const {
+        return vertices > 1 ? 2.0 * edges / ((double)vertices * (vertices - 1)) : 0;
+    }
+
+    SigmaKernel resolve_kernel(SigmaKernel kernel) {
+        if (kernel == KERNEL_AUTO) kernel = density() >= DENSE_MIN_DENSITY ? KERNEL_DENSE : KERNEL_SPARSE;
+        // scan and dense read the matrix, which is only there for small graphs
+        if (kernel != KERNEL_SPARSE && adj_matrix.empty()) kernel = KERNEL_SPARSE;
+        return kernel;
+    }
+
+    // heaviest positive edge, the dense kernel takes the row maxima of the upper triangle of the matrix
+    // and gives the same edge as heaviest_edge
+    bool seed_edge(int &max_u, int &max_v, SigmaKernel kernel) {
+        if (kernel == KERNEL_DENSE) {
+            int best = 0;
+            for (int u = 1; u < vertices; u++) {
+                const int *row = adj_matrix[u].data() + u + 1;
+                int m = row_max(row, vertices - u);
+                if (m > best) {
+                    best = m;
                     max_u = u;
-                    max_v = v;
+                    max_v = u + 1 + (find(row, row + vertices - u, m) - row);
                 }
             }
+            // a zero entry is a missing edge, so without a positive edge the matrix can't tell
+            if (best > 0) return true;
+        }
+        return heaviest_edge(max_u, max_v);
+    }
+
+    // weights from every vertex to set1 and set2 for the greedy heuristics
+    struct SetSigma {
+        Graph &g;
+        SigmaKernel kernel;
+        vector<int> set1, set2;
+        vector<long long> sigma1, sigma2;
+
+        SetSigma(Graph &g, SigmaKernel kernel) : g(g), kernel(kernel) {
+            if (kernel != KERNEL_SCAN) {
+                sigma1.assign(g.vertices + 1, 0);
+                sigma2.assign(g.vertices + 1, 0);
+            }
+        }
+
+        long long to_set1(int v) {
+            return kernel == KERNEL_SCAN ? g.calculate_w(v, set1) : sigma1[v];
+        }
+
+        long long to_set2(int v) {
+            return kernel == KERNEL_SCAN ? g.calculate_w(v, set2) : sigma2[v];
+        }
+
+        void place(int v, bool in_set2) {
+            (in_set2 ? set2 : set1).push_back(v);
+            vector<long long> &sigma = in_set2 ? sigma2 : sigma1;
+            if (kernel == KERNEL_DENSE) {
+                add_row(sigma.data(), g.adj_matrix[v].data(), g.vertices + 1);
+            }
+            else if (kernel == KERNEL_SPARSE) {
+                for (int k = g.adj_start[v]; k < g.adj_start[v + 1]; k++) sigma[g.adj[k]] += g.adj_weight[k];
+            }
         }
+    };
 
-        //Adding the maximum edge to set1
-        set1.push_back(max_u);
-        set1.push_back(max_v);
-        visited[max_u] = true;
-        visited[max_v] = true;
+    double greedy_heuristic(SigmaKernel kernel = KERNEL_AUTO) {
+        kernel = resolve_kernel(kernel);
+        SetSigma sets(*this, kernel);
+        vector<bool> visited(vertices + 1, false);
+    
+        //Finding the maximum edge, its endpoints start on opposite sides
+        int max_u, max_v;
+        if (seed_edge(max_u, max_v, kernel)) {
+            sets.place(max_u, false);
+            sets.place(max_v, true);
+            visited[max_u] = true;
+            visited[max_v] = true;
+        }
 
         // for each vertex have 
         for (int i= 1 ; i<= vertices ; i++){
             if (!visited[i]){
 
-                int w_x = calculate_w(i, set2);
-                int w_y = calculate_w(i, set1);
-                if (w_x > w_y){
-                    set1.push_back(i);
-                    visited[i] = true;
-                }
-                else{
-                    set2.push_back(i);
-                    visited[i] = true;
-                }
+                long long w_x = sets.to_set2(i);
+                long long w_y = sets.to_set1(i);
+                sets.place(i, !(w_x > w_y));
+                visited[i] = true;
 
             }
 
@@ -153,53 +608,43 @@ class Graph{
 
 
         // finding cut weight
-        int cut_weight = calculate_cut_weight(set1, set2);
+        long long cut_weight = calculate_cut_weight(sets.set1, sets.set2);
        
 
         return cut_weight;
     }
 
 
-    pair <vector<int>,vector<int>> semi_greedy_heuristic(double alpha) {
-        vector<int> set1, set2;
+    pair <vector<int>,vector<int>> semi_greedy_heuristic(double alpha, SigmaKernel kernel = KERNEL_AUTO) {
+        kernel = resolve_kernel(kernel);
+        SetSigma sets(*this, kernel);
         vector<bool> visited(vertices + 1, false);
     
         // Step 1: Find the maximum weight edge
-        int max_u = -1, max_v = -1, max_weight = -1;
-        for (int u = 1; u <= vertices; u++) {
-            for (int v = u + 1; v <= vertices; v++) {
-                if (adj_matrix[u][v] > max_weight) {
-                    max_weight = adj_matrix[u][v];
-                    max_u = u;
-                    max_v = v;
-                }
-            }
+        int max_u, max_v;
+        if (seed_edge(max_u, max_v, kernel)) {
+            sets.place(max_u, false);
+            sets.place(max_v, true);
+            visited[max_u] = true;
+            visited[max_v] = true;
         }
     
-        set1.push_back(max_u);
-        set2.push_back(max_v);
-        visited[max_u] = true;
-        visited[max_v] = true;
-    
-        while (set1.size() + set2.size() < vertices) {
-            vector<int> candidates;
+        vector<int> candidates;
+        vector<long long> greedy_values;
+        while ((int)(sets.set1.size() + sets.set2.size()) < vertices) {
+            candidates.clear();
             for (int i = 1; i <= vertices; i++) {
                 if (!visited[i]) candidates.push_back(i);
             }
     
-            vector<int> greedy_values(candidates.size());
-            for (int i = 0; i < candidates.size(); i++) {
+            greedy_values.resize(candidates.size());
+            for (int i = 0; i < (int)candidates.size(); i++) {
                 int v = candidates[i];
-                int sigma1 = 0, sigma2 = 0;
-                sigma1 = calculate_w(v, set1);
-                sigma2 = calculate_w(v, set2);
-                // for (int u : set1) sigma1 += adj_matrix[v][u];
-                // for (int u : set2) sigma2 += adj_matrix[v][u];
-                greedy_values[i] = max(sigma1, sigma2);
+                greedy_values[i] = max(sets.to_set1(v), sets.to_set2(v));
             }
     
-            int w_min = greedy_values[0], w_max = greedy_values[0];
-            for (int val : greedy_values) {
+            long long w_min = greedy_values[0], w_max = greedy_values[0];
+            for (long long val : greedy_values) {
                 if (val < w_min) w_min = val;
                 if (val > w_max) w_max = val;
             }
@@ -208,42 +653,24 @@ class Graph{
     
             // Build RCL
             vector<int> RCL;
-            for (int i = 0; i < candidates.size(); i++) {
+            for (int i = 0; i < (int)candidates.size(); i++) {
                 if (greedy_values[i] >= mu) {
                     RCL.push_back(candidates[i]);
                 }
             }
     
             // Randomly select from RCL
-            int chosen_index = rand() % RCL.size();
+            int chosen_index = random_int(RCL.size());
             int chosen_vertex = RCL[chosen_index];
             visited[chosen_vertex] = true;
     
-            // Recompute sigma for placement
-            int sigma1 = 0, sigma2 = 0;
-            sigma1 = calculate_w(chosen_vertex, set1);
-            sigma2 = calculate_w(chosen_vertex, set2);
-            // for (int u : set1) sigma1 += adj_matrix[chosen_vertex][u];
-            // for (int u : set2) sigma2 += adj_matrix[chosen_vertex][u];
-    
-            if (sigma1 >= sigma2)
-                set2.push_back(chosen_vertex);
-            else
-                set1.push_back(chosen_vertex);
-        }
-    
-        // Calculate cut value
-        int cut_value = 0;
-        for (int u : set1) {
-            for (int v : set2) {
-                cut_value += adj_matrix[u][v];
-            }
+            // placement
+            sets.place(chosen_vertex, sets.to_set1(chosen_vertex) >= sets.to_set2(chosen_vertex));
         }
-        // cout << "semi_greedy_heuristic: " << cut_value << endl;
 
 
     
-        return make_pair(set1, set2);
+        return make_pair(sets.set1, sets.set2);
     }
 
     
@@ -253,13 +680,13 @@ class Graph{
     {
         while (true)
         {
-            int max_delta = 0 ;
+            long long max_delta = 0 ;
             bool isSet1 = false;
             int element = -1;
             for(auto v : set1){
-                int sigma_current = calculate_w(v, set1);
-                int sigma_opposite = calculate_w(v, set2);
-                int delta =sigma_current - sigma_opposite;
+                long long sigma_current = calculate_w(v, set1);
+                long long sigma_opposite = calculate_w(v, set2);
+                long long delta =sigma_current - sigma_opposite;
                 if (delta > max_delta)
                 {
                     max_delta = delta;
@@ -270,9 +697,9 @@ class Graph{
 
             }
             for(auto v : set2){
-                int sigma_current = calculate_w(v, set2);
-                int sigma_opposite = calculate_w(v, set1);
-                int delta =sigma_current - sigma_opposite;
+                long long sigma_current = calculate_w(v, set2);
+                long long sigma_opposite = calculate_w(v, set1);
+                long long delta =sigma_current - sigma_opposite;
                 if (delta > max_delta)
                 {
                     max_delta = delta;
@@ -312,139 +739,2241 @@ class Graph{
 }
 
 
-double Local_search_for_csv (int maxIterations, double alpha) {
-    vector<int> set1, set2;
-    double total_cut_weight = 0;
+    // --- partition as a Solution with incremental gains ---
+
+    void prepare(GraspWorkspace &ws) {
+        ws.current.resize(vertices);
+        ws.relinked.resize(vertices);
+        ws.best.resize(vertices);
+        ws.best.cut = LLONG_MIN;
+        ws.tabu_best.resize(vertices);
+        ws.sigma1.assign(vertices + 1, 0);
+        ws.sigma2.assign(vertices + 1, 0);
+        ws.values.assign(vertices + 1, 0);
+        ws.position.assign(vertices + 1, 0);
+        ws.tabu_until.assign(vertices + 1, 0);
+        ws.candidates.reserve(vertices);
+        ws.rcl.reserve(vertices);
+        ws.diff.reserve(vertices);
+        ws.flips.reserve(vertices);
+    }
 
-    for (int i = 0; i < maxIterations; i++) {
-        pair<vector<int>, vector<int>> sets = semi_greedy_heuristic(alpha);
-        set1 = sets.first;
-        set2 = sets.second;
+    // cut weight and gains of the partition held in s.bits
+    void evaluate(Solution &s) {
+        s.cut = 0;
+        for (int v = 1; v <= vertices; v++) {
+            long long g = 0;
+            int sv = s.side(v);
+            for (int k = adj_start[v]; k < adj_start[v + 1]; k++) {
+                if (s.side(adj[k]) == sv) g += adj_weight[k];
+                else g -= adj_weight[k];
+            }
+            s.gain[v] = g;
+        }
+        for (int j = 0; j < edges; j++) {
+            s.cut += (s.side(edge_u[j]) ^ s.side(edge_v[j])) * (long long)edge_w[j];
+        }
+    }
 
-        pair<vector<int>, vector<int>> local_sets = local_search_heuristic(set1, set2);
-        set1 = local_sets.first;
-        set2 = local_sets.second;
+    void set_solution(Solution &s, const vector<int> &set1, const vector<int> &set2) {
+        vector<char> side = to_sides(set1, set2);
+        s.resize(vertices);
+        for (int v = 1; v <= vertices; v++) {
+            if (side[v]) s.flip_bit(v);
+        }
+        evaluate(s);
+    }
 
-        int cut = calculate_cut_weight(set1, set2);
-         total_cut_weight += cut;
+    pair<vector<int>, vector<int>> solution_sets(const Solution &s) {
+        vector<int> set1, set2;
+        for (int v = 1; v <= vertices; v++) {
+            if (s.side(v) == 0) set1.push_back(v);
+            else set2.push_back(v);
+        }
+        return make_pair(set1, set2);
     }
 
-    return total_cut_weight / maxIterations;
+    // side of every vertex, set1 and set2 have to partition the vertices
+    vector<char> to_sides(const vector<int> &set1, const vector<int> &set2) {
+        const char unassigned = 2;
+        vector<char> side(vertices + 1, unassigned);
+        side[0] = 0;
+        for (int v : set1) {
+            assert(side[v] == unassigned);
+            side[v] = 0;
+        }
+        for (int v : set2) {
+            assert(side[v] == unassigned);
+            side[v] = 1;
+        }
+        assert(count(side.begin(), side.end(), unassigned) == 0);
+        return side;
+    }
 
-}
+    pair<vector<int>, vector<int>> from_sides(const vector<char> &side) {
+        vector<int> set1, set2;
+        for (int v = 1; v <= vertices; v++) {
+            if (side[v] == 0) set1.push_back(v);
+            else set2.push_back(v);
+        }
+        return make_pair(set1, set2);
+    }
 
+    // gain[v] is the change of the cut weight when v is moved to the other set
+    void flip(Solution &s, int v) {
+        s.cut += s.gain[v];
+        s.gain[v] = -s.gain[v];
+        s.flip_bit(v);
+        int sv = s.side(v);
+        for (int k = adj_start[v]; k < adj_start[v + 1]; k++) {
+            int u = adj[k];
+            // edge (u,v) became uncut if they are now on the same side, so moving u would cut it again
+            if (s.side(u) == sv) s.gain[u] += 2LL * adj_weight[k];
+            else s.gain[u] -= 2LL * adj_weight[k];
+        }
+    }
 
+    // best improvement 1-flip local search, same moves as local_search_heuristic
+    void local_search(Solution &s) {
+        while (true) {
+            int best_v = -1;
+            long long best_gain = 0;
+            for (int v = 1; v <= vertices; v++) {
+                if (s.gain[v] > best_gain) {
+                    best_gain = s.gain[v];
+                    best_v = v;
+                }
+            }
+            if (best_v == -1) break;
+            flip(s, best_v);
+        }
+    }
 
+    // semi-greedy construction into s, the sums of the weights from every vertex to set1 and set2
+    // are kept up to date as vertices are placed instead of being recomputed for every candidate
+    void construct_semi_greedy(Solution &s, double alpha, GraspWorkspace &ws) {
+        fill(s.bits.begin(), s.bits.end(), 0);
+        fill(ws.sigma1.begin(), ws.sigma1.end(), 0);
+        fill(ws.sigma2.begin(), ws.sigma2.end(), 0);
+        ws.candidates.clear();
+        for (int v = 1; v <= vertices; v++) {
+            ws.position[v] = ws.candidates.size();
+            ws.candidates.push_back(v);
+        }
 
-pair<vector<int>, vector<int>> GRASP(int MaxIterations, double alpha) {
-    vector<int> best_set1, best_set2;
-    int best_cut = -1;
+        auto place = [&](int v, int side) {
+            if (side == 1) s.flip_bit(v);
+            int last = ws.candidates.back();
+            ws.candidates[ws.position[v]] = last;
+            ws.position[last] = ws.position[v];
+            ws.candidates.pop_back();
+            vector<long long> &sigma = side == 0 ? ws.sigma1 : ws.sigma2;
+            for (int k = adj_start[v]; k < adj_start[v + 1]; k++) sigma[adj[k]] += adj_weight[k];
+        };
+
+        int max_u = -1, max_v = -1;
+        if (heaviest_edge(max_u, max_v)) {
+            place(max_u, 0);
+            place(max_v, 1);
+        }
 
-    for (int i = 0; i < MaxIterations; i++) {
-        // --- Construction Phase ---
-        vector<int> set1, set2;
+        while (!ws.candidates.empty()) {
+            int count = ws.candidates.size();
+            long long w_min = LLONG_MAX, w_max = LLONG_MIN;
+            for (int i = 0; i < count; i++) {
+                int v = ws.candidates[i];
+                long long value = max(ws.sigma1[v], ws.sigma2[v]);
+                ws.values[i] = value;
+                w_min = min(w_min, value);
+                w_max = max(w_max, value);
+            }
 
-        pair<vector<int>, vector<int>> sets = semi_greedy_heuristic(alpha);
-        set1 = sets.first;
-        set2 = sets.second;
-        // set1 = semi_greedy_heuristic(alpha).first; // modifies set1 and set2
-        // set2 = semi_greedy_heuristic(alpha).second;
-      
-        // --- Local Search Phase ---
-        pair<vector<int>, vector<int>> local_sets = local_search_heuristic(set1, set2);
-        set1 = local_sets.first;
-        set2 = local_sets.second;
+            double mu = w_min + alpha * (w_max - w_min);
+            ws.rcl.clear();
+            for (int i = 0; i < count; i++) {
+                if (ws.values[i] >= mu) ws.rcl.push_back(ws.candidates[i]);
+            }
 
-        // --- Update best solution ---
-        int cut = calculate_cut_weight(set1, set2);
-        if (cut > best_cut) {
-            best_cut = cut;
-            best_set1 = set1;
-            best_set2 = set2;
+            int chosen_vertex = ws.rcl[random_int(ws.rcl.size())];
+            place(chosen_vertex, ws.sigma1[chosen_vertex] >= ws.sigma2[chosen_vertex] ? 1 : 0);
         }
+
+        evaluate(s);
     }
 
-    
+    // walk from start towards guide flipping the differing vertex with the best gain at each step,
+    // out ends as the best intermediate partition found on the path
+    void path_relinking(const Solution &start, const Solution &guide, Solution &out, GraspWorkspace &ws) {
+        ws.diff.clear();
+        for (int v = 1; v <= vertices; v++) {
+            if (start.side(v) != guide.side(v)) ws.diff.push_back(v);
+        }
+        // relink towards the complement of the guide when it is closer, it is the same cut
+        if ((int)ws.diff.size() * 2 > vertices) {
+            ws.diff.clear();
+            for (int v = 1; v <= vertices; v++) {
+                if (start.side(v) == guide.side(v)) ws.diff.push_back(v);
+            }
+        }
 
-    return {best_set1, best_set2};
-}
+        out.copy_from(start);
+        ws.flips.clear();
+        long long best_cut = LLONG_MIN;
+        int best_step = 0;
+        // the last flip reaches the guide itself so it is not an intermediate solution
+        while (ws.diff.size() > 1) {
+            int pick = 0;
+            for (int i = 1; i < (int)ws.diff.size(); i++) {
+                if (out.gain[ws.diff[i]] > out.gain[ws.diff[pick]]) pick = i;
+            }
+            int v = ws.diff[pick];
+            ws.diff[pick] = ws.diff.back();
+            ws.diff.pop_back();
+
+            flip(out, v);
+            ws.flips.push_back(v);
+            if (out.cut > best_cut) {
+                best_cut = out.cut;
+                best_step = ws.flips.size();
+            }
+        }
 
+        // undo the flips made after the best point of the path
+        for (int i = ws.flips.size() - 1; i >= best_step; i--) flip(out, ws.flips[i]);
+    }
 
+    // tabu search on 1-flip moves, optionally also moving both ends of an edge at once (2-flip)
+    // a moved vertex stays tabu for tenure moves unless moving it gives a new best cut (aspiration)
+    // stops after max_no_improve moves without a new best and restores the best partition found
+    void tabu_search(Solution &s, GraspWorkspace &ws, int tenure, int max_no_improve, bool two_flip) {
+        fill(ws.tabu_until.begin(), ws.tabu_until.end(), 0);
+        Solution &best = ws.tabu_best;
+        best.copy_from(s);
+        int no_improve = 0;
+
+        for (int move = 1; no_improve < max_no_improve; move++) {
+            int best_u = -1, best_v = -1;
+            long long best_gain = LLONG_MIN;
+
+            for (int v = 1; v <= vertices; v++) {
+                bool allowed = ws.tabu_until[v] < move || s.cut + s.gain[v] > best.cut;
+                if (allowed && s.gain[v] > best_gain) {
+                    best_gain = s.gain[v];
+                    best_u = v;
+                    best_v = -1;
+                }
+            }
 
-   
+            if (two_flip) {
+                for (int u = 1; u <= vertices; u++) {
+                    for (int k = adj_start[u]; k < adj_start[u + 1]; k++) {
+                        int v = adj[k];
+                        if (v < u) continue;
+                        // moving u changes gain[v] by +2w if they were on different sides, -2w otherwise
+                        long long w = adj_weight[k];
+                        long long pair_gain = s.gain[u] + s.gain[v] + (s.side(u) != s.side(v) ? 2 * w : -2 * w);
+                        bool allowed = (ws.tabu_until[u] < move && ws.tabu_until[v] < move) || s.cut + pair_gain > best.cut;
+                        if (allowed && pair_gain > best_gain) {
+                            best_gain = pair_gain;
+                            best_u = u;
+                            best_v = v;
+                        }
+                    }
+                }
+            }
 
-};
+            if (best_u == -1) break; // every move is tabu
 
-map<string, int> known_best = {
-    {"G1", 12078}, {"G2", 12084}, {"G3", 12077}, {"G11", 627}, {"G12", 621}, {"G13", 645}, {"G14", 3187}, {"G15", 3169},
-    {"G16", 3172}, {"G22", 14123}, {"G23", 14129}, {"G24", 14131}, {"G32", 1560}, {"G33", 1537}, {"G34", 1541},
-    {"G35", 8000}, {"G36", 7996}, {"G37", 8009}, {"G43", 7027}, {"G44", 7022}, {"G45", 7020}, {"G48", 6000},
-    {"G49", 6000}, {"G50", 5988}
-};
+            flip(s, best_u);
+            ws.tabu_until[best_u] = move + tenure + random_int(tenure + 1);
+            if (best_v != -1) {
+                flip(s, best_v);
+                ws.tabu_until[best_v] = move + tenure + random_int(tenure + 1);
+            }
 
-int main() {
-    srand(time(0)); // seed randomness
+            if (s.cut > best.cut) {
+                best.copy_from(s);
+                no_improve = 0;
+            }
+            else {
+                no_improve++;
+            }
+        }
 
-    ofstream fout("2105106.csv"); // change to your student ID
-    fout << "Name,|V| or n,|E| or m ,Simple Randomized or Randomized 1,Simple Greedy or Greedy 1,Semi-Greedy 1,LocalSearch-Iterations,LocalSearch-Average value,GRASP-Iterations,GRASP-Best Value,Known Best\n";
+        s.copy_from(best);
+    }
 
-    for (int i = 1; i <= 54; i++) {
-        string file_name = "input_graphs/g"+ to_string(i) + ".rud";
-        ifstream fin(file_name);
-        if (!fin) {
-            cerr << "Cannot open " << file_name << endl;
-            continue;
+    // improvement phase of GRASP
+    void improve(Solution &s, ImprovementMode improvement, GraspWorkspace &ws) {
+        local_search(s);
+        if (improvement != LOCAL_SEARCH) {
+            tabu_search(s, ws, max(10, vertices / 100), vertices, improvement == TABU_SEARCH_2FLIP);
         }
-         cout << "Processing " << file_name << endl;
-        int vertices, edges;
-        fin >> vertices >> edges;
-        Graph g(vertices, edges);
+    }
 
-        for (int j = 0; j < edges; j++) {
-            int u, v, w;
-            fin >> u >> v >> w;
-            g.add_edge(u, v, w);
-        }
+    // one GRASP iteration in ws.current, ws.best is only copied into when the cut improves on it
+    // returns the cut of the iteration, no allocation happens once ws has been prepared
+    long long grasp_iteration(GraspWorkspace &ws, double alpha, ImprovementMode improvement) {
+        // --- Construction Phase ---
+        construct_semi_greedy(ws.current, alpha, ws);
+        // --- Local Search Phase ---
+        improve(ws.current, improvement, ws);
+        // --- Update best solution ---
+        if (ws.current.cut > ws.best.cut) ws.best.copy_from(ws.current);
+        return ws.current.cut;
+    }
 
-        int greedy_val = g.greedy_heuristic();
-        int randomized_val = g.randomized_heuristic(10);
-        auto semi_sets = g.semi_greedy_heuristic(0.5);
-        int semi_val = g.calculate_cut_weight(semi_sets.first, semi_sets.second);
-   
-        
 
-        int local_iters = 1;
-        int grasp_iters = 1;
+double Local_search_for_csv (int maxIterations, double alpha) {
+    GraspWorkspace ws;
+    prepare(ws);
+    double total_cut_weight = 0;
 
+    for (int i = 0; i < maxIterations; i++) {
+        total_cut_weight += grasp_iteration(ws, alpha, LOCAL_SEARCH);
+    }
 
-        if (vertices < 1000){
-            local_iters = 50;
-            grasp_iters = 50;
-        }
-       
-        else{
-            local_iters = 10;
-            grasp_iters = 10;
-        }
-        int local_avg = g.Local_search_for_csv(local_iters ,  0.5); // Returns average or best
-        
+    return total_cut_weight / maxIterations;
 
-        
-        auto grasp_sets = g.GRASP(grasp_iters, 0.5);
-        int grasp_val = g.calculate_cut_weight(grasp_sets.first, grasp_sets.second);
+}
 
-        string graph_id = "G" + to_string(i);
-        int known = known_best.count(graph_id) ? known_best[graph_id] : 0;
 
 
-        fout << graph_id << "," << vertices << "," << edges << "," << randomized_val << "," << greedy_val << ","
-             << semi_val << "," << local_iters << "," << local_avg << "," << grasp_iters << "," << grasp_val << "," << known << "\n";
-        
 
-    cout << "Graph " << i << " processed." << endl;
-        fin.close();
+pair<vector<int>, vector<int>> GRASP(int MaxIterations, double alpha, ImprovementMode improvement = LOCAL_SEARCH) {
+    GraspWorkspace ws;
+    prepare(ws);
+
+    for (int i = 0; i < MaxIterations; i++) {
+        grasp_iteration(ws, alpha, improvement);
     }
 
-    fout.close();
-    return 0;
-}
\ No newline at end of file
+    return solution_sets(ws.best);
+}
+
+
+// GRASP that runs until a wall-clock deadline or until the target cut value is reached
+// target <= 0 means there is no target, only the deadline stops the search
+TimedGraspResult GRASP_timed(double time_limit, long long target, double alpha, ImprovementMode improvement = LOCAL_SEARCH) {
+    TimedGraspResult result;
+    GraspWorkspace ws;
+    prepare(ws);
+    auto start = chrono::steady_clock::now();
+    auto elapsed_seconds = [&]() {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    while (elapsed_seconds() < time_limit) {
+        long long cut = grasp_iteration(ws, alpha, improvement);
+        result.iterations++;
+
+        if (cut > result.best_cut) {
+            result.best_cut = cut;
+            result.trace.push_back({elapsed_seconds(), cut});
+        }
+
+        if (target > 0 && result.best_cut >= target) {
+            result.time_to_target = elapsed_seconds();
+            break;
+        }
+    }
+
+    if (result.iterations > 0) result.best_sets = solution_sets(ws.best);
+    result.elapsed = elapsed_seconds();
+    return result;
+}
+
+    // one GRASP iteration whose local optimum is relinked with a random elite partition, returns its cut
+    long long path_relinking_iteration(GraspWorkspace &ws, ElitePool &pool, double alpha) {
+        // --- Construction and Local Search Phase ---
+        construct_semi_greedy(ws.current, alpha, ws);
+        local_search(ws.current);
+
+        // --- Path Relinking Phase ---
+        if (!pool.members.empty()) {
+            const Solution &guide = pool.members[random_int(pool.members.size())];
+            path_relinking(ws.current, guide, ws.relinked, ws);
+            local_search(ws.relinked);
+
+            if (ws.relinked.cut > ws.current.cut) {
+                pool.try_add(ws.current);
+                swap(ws.current, ws.relinked);
+            }
+        }
+
+        pool.try_add(ws.current);
+        if (ws.current.cut > ws.best.cut) ws.best.copy_from(ws.current);
+        return ws.current.cut;
+    }
+
+    // GRASP with an elite pool, every local optimum is relinked with a random elite partition
+    pair<vector<int>, vector<int>> GRASP_path_relinking(int MaxIterations, double alpha, int elite_size) {
+        ElitePool pool(elite_size, max(1, vertices / 100), vertices);
+        GraspWorkspace ws;
+        prepare(ws);
+
+        for (int i = 0; i < MaxIterations; i++) {
+            path_relinking_iteration(ws, pool, alpha);
+        }
+
+        return solution_sets(ws.best);
+    }
+
+    // reactive GRASP: alpha is drawn from a discrete set, every block iterations the probability of
+    // alpha i becomes proportional to ((avg_i - worst) / (best - worst))^delta over the cuts seen so far
+    ReactiveGraspResult GRASP_reactive(double time_limit, long long target, vector<double> alphas, int block = 10, double delta = 10,
+                                       ImprovementMode improvement = LOCAL_SEARCH) {
+        ReactiveGraspResult result;
+        int m = alphas.size();
+        result.alphas = alphas;
+        result.probabilities.assign(m, 1.0 / m);
+        result.uses.assign(m, 0);
+        vector<double> cut_sum(m, 0);
+        long long worst_cut = LLONG_MAX;
+        GraspWorkspace ws;
+        prepare(ws);
+
+        TimedGraspResult &run = result.run;
+        auto start = chrono::steady_clock::now();
+        auto elapsed_seconds = [&]() {
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        while (elapsed_seconds() < time_limit) {
+            // roulette wheel selection of alpha
+            double r = uniform(rng);
+            int a = m - 1;
+            for (int i = 0; i < m; i++) {
+                r -= result.probabilities[i];
+                if (r <= 0) {
+                    a = i;
+                    break;
+                }
+            }
+
+            long long cut = grasp_iteration(ws, alphas[a], improvement);
+            run.iterations++;
+
+            result.uses[a]++;
+            cut_sum[a] += cut;
+            worst_cut = min(worst_cut, cut);
+            if (cut > run.best_cut) {
+                run.best_cut = cut;
+                run.trace.push_back({elapsed_seconds(), cut});
+            }
+            if (target > 0 && run.best_cut >= target) {
+                run.time_to_target = elapsed_seconds();
+                break;
+            }
+
+            if (run.iterations % block == 0 && run.best_cut > worst_cut) {
+                vector<double> q(m);
+                double q_sum = 0, q_used = 0;
+                int used = 0;
+                for (int i = 0; i < m; i++) {
+                    if (result.uses[i] == 0) continue;
+                    double avg = cut_sum[i] / result.uses[i];
+                    q[i] = pow((avg - worst_cut) / (run.best_cut - worst_cut), delta) + 1e-3;
+                    q_used += q[i];
+                    used++;
+                }
+                // alphas that were never drawn keep an average share so they still get tried
+                for (int i = 0; i < m; i++) {
+                    if (result.uses[i] == 0) q[i] = q_used / used;
+                    q_sum += q[i];
+                }
+                for (int i = 0; i < m; i++) result.probabilities[i] = q[i] / q_sum;
+                result.history.push_back({run.iterations, result.probabilities});
+            }
+        }
+
+        if (run.iterations > 0) run.best_sets = solution_sets(ws.best);
+        run.elapsed = elapsed_seconds();
+        return result;
+    }
+
+
+    // --- multilevel solver ---
+
+    int vertex_count() const {
+        return vertices;
+    }
+
+    int edge_count() const {
+        return edges;
+    }
+
+    // first improvement local search driven by a stack of vertices with a positive gain, a move only
+    // looks at the neighbors of the moved vertex so it scales to graphs where a full scan per move is too slow
+    void local_search_queue(Solution &s) {
+        vector<int> all(vertices);
+        for (int v = 1; v <= vertices; v++) all[v - 1] = v;
+        local_search_from(s, all);
+    }
+
+    // the same local search when only the vertices in start can have a positive gain
+    void local_search_from(Solution &s, const vector<int> &start) {
+        vector<int> pending;
+        vector<char> queued(vertices + 1, 0);
+        for (int v : start) {
+            if (s.gain[v] > 0 && !queued[v]) {
+                pending.push_back(v);
+                queued[v] = 1;
+            }
+        }
+        while (!pending.empty()) {
+            int v = pending.back();
+            pending.pop_back();
+            queued[v] = 0;
+            if (s.gain[v] <= 0) continue;
+            flip(s, v);
+            for (int k = adj_start[v]; k < adj_start[v + 1]; k++) {
+                int u = adj[k];
+                if (s.gain[u] > 0 && !queued[u]) {
+                    pending.push_back(u);
+                    queued[u] = 1;
+                }
+            }
+        }
+    }
+
+    // heavy-edge matching: every vertex, in random order, is merged with the free neighbor joined by the
+    // edge of largest absolute weight, the pair is put on opposite sides for a positive edge so the edge
+    // is always cut, and on the same side for a negative one
+    // the edges of the coarse graph keep their weight between vertices with the same orientation and are
+    // negated between opposite ones, edges inside a pair are dropped, parallel edges are summed
+    Graph coarsen(CoarseLevel &level) {
+        vector<int> order(vertices);
+        for (int v = 1; v <= vertices; v++) order[v - 1] = v;
+        shuffle(order.begin(), order.end(), rng);
+
+        level.parent.assign(vertices + 1, 0);
+        level.flipped.assign(vertices + 1, 0);
+        int coarse_vertices = 0;
+        for (int v : order) {
+            if (level.parent[v]) continue;
+            int best_u = -1, best_w = 0;
+            for (int k = adj_start[v]; k < adj_start[v + 1]; k++) {
+                int u = adj[k];
+                if (u != v && !level.parent[u] && abs(adj_weight[k]) > abs(best_w)) {
+                    best_u = u;
+                    best_w = adj_weight[k];
+                }
+            }
+            level.parent[v] = ++coarse_vertices;
+            if (best_u != -1) {
+                level.parent[best_u] = coarse_vertices;
+                level.flipped[best_u] = best_w > 0;
+            }
+        }
+
+        // project the edges, bucketed by their smaller coarse endpoint
+        vector<int> bucket_start(coarse_vertices + 2, 0);
+        for (int j = 0; j < edges; j++) {
+            int a = level.parent[edge_u[j]], b = level.parent[edge_v[j]];
+            if (a != b) bucket_start[min(a, b) + 1]++;
+        }
+        for (int i = 1; i <= coarse_vertices + 1; i++) bucket_start[i] += bucket_start[i - 1];
+        vector<int> bucket(bucket_start[coarse_vertices + 1]);
+        vector<int> pos(bucket_start.begin(), bucket_start.end() - 1);
+        for (int j = 0; j < edges; j++) {
+            int a = level.parent[edge_u[j]], b = level.parent[edge_v[j]];
+            if (a != b) bucket[pos[min(a, b)]++] = j;
+        }
+
+        // merge parallel edges, slot[b] is the output index of edge (a,b) while a is being merged
+        vector<int> cu, cv;
+        vector<long long> cw;
+        vector<int> slot(coarse_vertices + 1, -1);
+        for (int a = 1; a <= coarse_vertices; a++) {
+            int first = cu.size();
+            for (int k = bucket_start[a]; k < bucket_start[a + 1]; k++) {
+                int j = bucket[k];
+                int b = level.parent[edge_u[j]] ^ level.parent[edge_v[j]] ^ a;
+                long long w = level.flipped[edge_u[j]] == level.flipped[edge_v[j]] ? edge_w[j] : -(long long)edge_w[j];
+                if (slot[b] < first) {
+                    slot[b] = cu.size();
+                    cu.push_back(a);
+                    cv.push_back(b);
+                    cw.push_back(w);
+                }
+                else {
+                    cw[slot[b]] += w;
+                }
+            }
+        }
+
+        vector<int> eu, ev, ew;
+        for (int j = 0; j < (int)cu.size(); j++) {
+            if (cw[j] == 0) continue;
+            eu.push_back(cu[j]);
+            ev.push_back(cv[j]);
+            // the CSR kernels work on int weights, a merged weight outside that range is clamped and counted
+            if (cw[j] < INT_MIN || cw[j] > INT_MAX) level.clamped++;
+            ew.push_back((int)max<long long>(INT_MIN, min<long long>(INT_MAX, cw[j])));
+        }
+        // the V-cycle only runs the CSR and edge list kernels on coarse levels
+        Graph coarse(coarse_vertices, eu.size(), eu, ev, ew, false);
+        coarse.seed(rng());
+        return coarse;
+    }
+
+    // fine holds the partition of this graph given by the partition of the coarse graph one level up
+    void project(const Solution &coarse, const CoarseLevel &level, Solution &fine) {
+        fine.resize(vertices);
+        for (int v = 1; v <= vertices; v++) {
+            if (coarse.side(level.parent[v]) ^ level.flipped[v]) fine.flip_bit(v);
+        }
+        evaluate(fine);
+    }
+
+    // multilevel Max-Cut: coarsens by heavy-edge matching down to about coarsest_size vertices, runs GRASP
+    // with tabu search on the coarsest graph, then projects the partition back level by level refining it
+    // with local search, V-cycles are repeated on the same hierarchy while the next one fits in the budget
+    MultilevelResult multilevel(double time_limit, int coarsest_size = 200, double coarsest_share = 0.2) {
+        MultilevelResult result;
+        auto start = chrono::steady_clock::now();
+        auto elapsed_seconds = [&]() {
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
+
+        // --- Coarsening Phase ---
+        vector<Graph> hierarchy;
+        vector<CoarseLevel> maps;
+        auto level_graph = [&](int i) -> Graph & {
+            return i == 0 ? *this : hierarchy[i - 1];
+        };
+        while (level_graph(maps.size()).vertices > coarsest_size) {
+            Graph &fine = level_graph(maps.size());
+            CoarseLevel level;
+            Graph coarse = fine.coarsen(level);
+            // stop when matching no longer shrinks the graph, e.g. when few edges are left
+            if (coarse.vertices > 0.9 * fine.vertices) break;
+            result.clamped_edges += level.clamped;
+            maps.push_back(move(level));
+            hierarchy.push_back(move(coarse));
+        }
+        int levels = maps.size();
+        Graph &coarsest = level_graph(levels);
+        result.levels = levels;
+        result.coarsest_vertices = coarsest.vertices;
+        result.coarsen_seconds = elapsed_seconds();
+
+        GraspWorkspace ws;
+        coarsest.prepare(ws);
+        Solution current, finer, best;
+        best.cut = LLONG_MIN;
+
+        while (true) {
+            double cycle_start = elapsed_seconds();
+
+            // --- GRASP on the coarsest graph ---
+            ws.best.cut = LLONG_MIN;
+            double coarse_budget = coarsest_share * (time_limit - result.coarsen_seconds);
+            do {
+                coarsest.grasp_iteration(ws, 0.5, TABU_SEARCH);
+            } while (elapsed_seconds() - cycle_start < coarse_budget);
+
+            // --- Uncoarsening with refinement ---
+            current.copy_from(ws.best);
+            for (int i = levels; i > 0; i--) {
+                Graph &fine = level_graph(i - 1);
+                fine.project(current, maps[i - 1], finer);
+                fine.local_search_queue(finer);
+                swap(current, finer);
+            }
+
+            result.cycles++;
+            if (current.cut > best.cut) {
+                best.copy_from(current);
+                result.trace.push_back({elapsed_seconds(), best.cut});
+            }
+            double cycle_seconds = elapsed_seconds() - cycle_start;
+            if (elapsed_seconds() + cycle_seconds > time_limit) break;
+        }
+
+        result.best_cut = best.cut;
+        result.best_sets = solution_sets(best);
+        result.elapsed = elapsed_seconds();
+        return result;
+    }
+
+
+    // --- incremental updates ---
+
+    // copies of the current edge list
+    void edge_list(vector<int> &eu, vector<int> &ev, vector<int> &ew) const {
+        eu = edge_u;
+        ev = edge_v;
+        ew = edge_w;
+    }
+
+    // applies edge insertions, deletions and weight changes, s keeps its partition and only the gains of
+    // the endpoints of changed edges are updated, changed gets those endpoints, the CSR arrays are rebuilt
+    // in O(V + E) and the vertex count stays the same
+    void apply_edge_deltas(const vector<EdgeDelta> &deltas, Solution &s, vector<int> &changed) {
+        unordered_map<long long, int> index;
+        auto key = [&](int u, int v) {
+            return (long long)min(u, v) * (vertices + 1) + max(u, v);
+        };
+        for (int j = 0; j < edges; j++) index.emplace(key(edge_u[j], edge_v[j]), j);
+
+        changed.clear();
+        for (auto &d : deltas) {
+            if (d.u == d.v || d.u < 1 || d.v < 1 || d.u > vertices || d.v > vertices) continue;
+            long long k = key(d.u, d.v);
+            auto it = index.find(k);
+            long long old_weight = it == index.end() ? 0 : edge_w[it->second];
+            if (old_weight == d.weight) continue;
+
+            if (it == index.end()) {
+                index[k] = edges++;
+                edge_u.push_back(d.u);
+                edge_v.push_back(d.v);
+                edge_w.push_back(d.weight);
+            }
+            else if (d.weight == 0) {
+                // swap the last edge into the hole
+                int j = it->second, last = edges - 1;
+                index.erase(it);
+                if (j != last) {
+                    edge_u[j] = edge_u[last];
+                    edge_v[j] = edge_v[last];
+                    edge_w[j] = edge_w[last];
+                    index[key(edge_u[j], edge_v[j])] = j;
+                }
+                edge_u.pop_back();
+                edge_v.pop_back();
+                edge_w.pop_back();
+                edges--;
+            }
+            else {
+                edge_w[it->second] = d.weight;
+            }
+            if (!adj_matrix.empty()) {
+                adj_matrix[d.u][d.v] = d.weight;
+                adj_matrix[d.v][d.u] = d.weight;
+            }
+
+            // a cut edge adds its weight to the cut and makes moving either endpoint that much worse
+            long long dw = d.weight - old_weight;
+            if (s.side(d.u) != s.side(d.v)) {
+                s.cut += dw;
+                s.gain[d.u] -= dw;
+                s.gain[d.v] -= dw;
+            }
+            else {
+                s.gain[d.u] += dw;
+                s.gain[d.v] += dw;
+            }
+            changed.push_back(d.u);
+            changed.push_back(d.v);
+        }
+        build_adjacency();
+    }
+
+    // warm start after apply_edge_deltas: s was a local optimum, so only the changed vertices can start
+    // an improving move
+    void resolve(Solution &s, const vector<int> &changed) {
+        local_search_from(s, changed);
+    }
+
+};
+
+map<string, int> known_best = {
+    {"G1", 12078}, {"G2", 12084}, {"G3", 12077}, {"G11", 627}, {"G12", 621}, {"G13", 645}, {"G14", 3187}, {"G15", 3169},
+    {"G16", 3172}, {"G22", 14123}, {"G23", 14129}, {"G24", 14131}, {"G32", 1560}, {"G33", 1537}, {"G34", 1541},
+    {"G35", 8000}, {"G36", 7996}, {"G37", 8009}, {"G43", 7027}, {"G44", 7022}, {"G45", 7020}, {"G48", 6000},
+    {"G49", 6000}, {"G50", 5988}
+};
+
+// write a binary copy of every graph next to its .rud file and read that on later runs
+bool use_binary_cache = false;
+
+// original reader, one integer at a time through the stream
+bool load_graph_stream(const string &file_name, int &vertices, int &edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+    ifstream fin(file_name);
+    if (!fin) {
+        cerr << "Cannot open " << file_name << endl;
+        return false;
+    }
+    fin >> vertices >> edges;
+    eu.resize(edges);
+    ev.resize(edges);
+    ew.resize(edges);
+    for (int j = 0; j < edges; j++) {
+        fin >> eu[j] >> ev[j] >> ew[j];
+    }
+    return true;
+}
+
+// reads the next integer, skipping the whitespace before it
+inline bool scan_int(const char *&p, const char *end, int &x) {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') return false;
+    x = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        x = x * 10 + (*p - '0');
+        p++;
+    }
+    if (negative) x = -x;
+    return true;
+}
+
+// memory maps the .rud file and parses it without going through iostreams
+bool load_graph_mmap(const string &file_name, int &vertices, int &edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Cannot open " << file_name << endl;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        cerr << "Cannot read " << file_name << endl;
+        return false;
+    }
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        cerr << "Cannot map " << file_name << endl;
+        return false;
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    const char *p = (const char *)data;
+    const char *end = p + st.st_size;
+    bool ok = scan_int(p, end, vertices) && scan_int(p, end, edges) && vertices >= 0 && edges >= 0;
+    if (ok) {
+        eu.resize(edges);
+        ev.resize(edges);
+        ew.resize(edges);
+        for (int j = 0; j < edges && ok; j++) {
+            ok = scan_int(p, end, eu[j]) && scan_int(p, end, ev[j]) && scan_int(p, end, ew[j])
+                 && eu[j] >= 1 && eu[j] <= vertices && ev[j] >= 1 && ev[j] <= vertices;
+        }
+    }
+    munmap(data, st.st_size);
+
+    if (!ok) cerr << "Malformed graph file " << file_name << endl;
+    return ok;
+}
+
+// binary cache: "RUDB", version, vertices, edges, then the u, v and w arrays as 32-bit integers
+const char BINARY_CACHE_MAGIC[4] = {'R', 'U', 'D', 'B'};
+const int BINARY_CACHE_VERSION = 1;
+
+string binary_cache_name(const string &file_name) {
+    return file_name + ".bin";
+}
+
+bool read_binary_cache(const string &file_name, int &vertices, int &edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+    struct stat rud_st, bin_st;
+    string cache_name = binary_cache_name(file_name);
+    if (stat(cache_name.c_str(), &bin_st) < 0) return false;
+    // a cache older than its source is stale
+    if (stat(file_name.c_str(), &rud_st) == 0 && rud_st.st_mtime > bin_st.st_mtime) return false;
+
+    ifstream fin(cache_name, ios::binary);
+    char magic[4];
+    int version;
+    fin.read(magic, 4);
+    fin.read((char *)&version, sizeof(int));
+    fin.read((char *)&vertices, sizeof(int));
+    fin.read((char *)&edges, sizeof(int));
+    if (!fin || memcmp(magic, BINARY_CACHE_MAGIC, 4) != 0 || version != BINARY_CACHE_VERSION || edges < 0) return false;
+    if ((long long)bin_st.st_size != 16 + 3 * (long long)edges * (long long)sizeof(int)) return false;
+
+    eu.resize(edges);
+    ev.resize(edges);
+    ew.resize(edges);
+    fin.read((char *)eu.data(), edges * sizeof(int));
+    fin.read((char *)ev.data(), edges * sizeof(int));
+    fin.read((char *)ew.data(), edges * sizeof(int));
+    return (bool)fin;
+}
+
+void write_binary_cache(const string &file_name, int vertices, int edges, const vector<int> &eu, const vector<int> &ev, const vector<int> &ew) {
+    string cache_name = binary_cache_name(file_name);
+    string tmp_name = cache_name + ".tmp";
+    ofstream fout(tmp_name, ios::binary);
+    fout.write(BINARY_CACHE_MAGIC, 4);
+    fout.write((const char *)&BINARY_CACHE_VERSION, sizeof(int));
+    fout.write((const char *)&vertices, sizeof(int));
+    fout.write((const char *)&edges, sizeof(int));
+    fout.write((const char *)eu.data(), edges * sizeof(int));
+    fout.write((const char *)ev.data(), edges * sizeof(int));
+    fout.write((const char *)ew.data(), edges * sizeof(int));
+    fout.close();
+    // rename so a concurrent reader never sees a half written cache
+    if (!fout || rename(tmp_name.c_str(), cache_name.c_str()) != 0) {
+        cerr << "Cannot write " << cache_name << endl;
+        remove(tmp_name.c_str());
+    }
+}
+
+// --- vertex reordering ---
+
+// relabeling of the vertices, new_id[v] is the label of original vertex v and original_id maps back
+struct VertexOrder {
+    vector<int> new_id, original_id;
+};
+
+// renumber the vertices with the given method applied to every graph at load time, "none" keeps the file order
+string reorder_method = "none";
+
+// order in which the vertices get their new labels
+// bfs: breadth first from a minimum degree vertex of every component
+// rcm: reverse Cuthill-McKee, breadth first visiting neighbors by increasing degree, then reversed
+// degree: decreasing degree, so the high degree vertices share cache lines
+vector<int> reorder_sequence(int vertices, int edges, const vector<int> &eu, const vector<int> &ev, const string &method) {
+    vector<int> degree(vertices + 2, 0);
+    for (int j = 0; j < edges; j++) {
+        degree[eu[j]]++;
+        degree[ev[j]]++;
+    }
+    vector<int> sequence;
+    if (method == "degree") {
+        for (int v = 1; v <= vertices; v++) sequence.push_back(v);
+        stable_sort(sequence.begin(), sequence.end(), [&](int a, int b) { return degree[a] > degree[b]; });
+        return sequence;
+    }
+
+    // neighbor lists in CSR form
+    vector<int> start(vertices + 2, 0);
+    for (int v = 1; v <= vertices; v++) start[v + 1] = start[v] + degree[v];
+    vector<int> pos(start.begin(), start.end() - 1), neighbor(2 * edges);
+    for (int j = 0; j < edges; j++) {
+        neighbor[pos[eu[j]]++] = ev[j];
+        neighbor[pos[ev[j]]++] = eu[j];
+    }
+
+    vector<int> roots;
+    for (int v = 1; v <= vertices; v++) roots.push_back(v);
+    stable_sort(roots.begin(), roots.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+    vector<char> visited(vertices + 1, 0);
+    for (int root : roots) {
+        if (visited[root]) continue;
+        visited[root] = 1;
+        size_t head = sequence.size();
+        sequence.push_back(root);
+        while (head < sequence.size()) {
+            int v = sequence[head++];
+            size_t first = sequence.size();
+            for (int k = start[v]; k < start[v + 1]; k++) {
+                int u = neighbor[k];
+                if (visited[u]) continue;
+                visited[u] = 1;
+                sequence.push_back(u);
+            }
+            if (method == "rcm") {
+                stable_sort(sequence.begin() + first, sequence.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+            }
+        }
+    }
+    if (method == "rcm") reverse(sequence.begin(), sequence.end());
+    return sequence;
+}
+
+// relabels the edge endpoints in place, order gets the maps between the two labelings
+bool reorder_graph(int vertices, int edges, vector<int> &eu, vector<int> &ev, const string &method, VertexOrder &order) {
+    if (method != "bfs" && method != "rcm" && method != "degree") return false;
+    vector<int> sequence = reorder_sequence(vertices, edges, eu, ev, method);
+    order.new_id.assign(vertices + 1, 0);
+    order.original_id.assign(vertices + 1, 0);
+    for (int i = 0; i < vertices; i++) {
+        order.new_id[sequence[i]] = i + 1;
+        order.original_id[i + 1] = sequence[i];
+    }
+    for (int j = 0; j < edges; j++) {
+        eu[j] = order.new_id[eu[j]];
+        ev[j] = order.new_id[ev[j]];
+    }
+    return true;
+}
+
+// partition of a reordered graph in terms of the original vertex numbers
+pair<vector<int>, vector<int>> to_original_ids(const pair<vector<int>, vector<int>> &sets, const VertexOrder &order) {
+    pair<vector<int>, vector<int>> original;
+    for (int v : sets.first) original.first.push_back(order.original_id[v]);
+    for (int v : sets.second) original.second.push_back(order.original_id[v]);
+    return original;
+}
+
+// average |u - v| over the edges, small when neighbors have close labels
+double average_edge_span(int edges, const vector<int> &eu, const vector<int> &ev) {
+    double span = 0;
+    for (int j = 0; j < edges; j++) span += abs(eu[j] - ev[j]);
+    return edges ? span / edges : 0;
+}
+
+// the cache always holds the file labels, the reordering is applied after reading, order (if given) gets the
+// maps back to the file labels
+bool load_graph(const string &file_name, int &vertices, int &edges, vector<int> &eu, vector<int> &ev, vector<int> &ew,
+                VertexOrder *order = nullptr) {
+    bool cached = use_binary_cache && read_binary_cache(file_name, vertices, edges, eu, ev, ew);
+    if (!cached) {
+        if (!load_graph_mmap(file_name, vertices, edges, eu, ev, ew)) return false;
+        if (use_binary_cache) write_binary_cache(file_name, vertices, edges, eu, ev, ew);
+    }
+    VertexOrder local_order;
+    reorder_graph(vertices, edges, eu, ev, reorder_method, order ? *order : local_order);
+    return true;
+}
+
+// reads only the vertex and edge counts of a graph file
+bool read_graph_header(const string &file_name, int &vertices, int &edges) {
+    ifstream fin(file_name);
+    return (bool)(fin >> vertices >> edges);
+}
+
+// input file of G<i>
+string graph_file(int i) {
+    return "input_graphs/g" + to_string(i) + ".rud";
+}
+
+// known best cut of a G-set graph, 0 when it is not known
+long long known_value(const string &graph_id) {
+    auto it = known_best.find(graph_id);
+    return it == known_best.end() ? 0 : it->second;
+}
+
+typedef function<void(int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew)> GraphVisitor;
+
+// loads G<i> for every i in graphs (G1 to G54 when empty) and calls visit on it, graph files that are missing
+// or have fewer than min_vertices vertices are skipped, the header is checked before the whole file is read
+void for_each_graph(const GraphVisitor &visit, const vector<int> &graphs = {}, int min_vertices = 0) {
+    vector<int> indices = graphs;
+    if (indices.empty()) {
+        for (int i = 1; i <= 54; i++) indices.push_back(i);
+    }
+    for (int i : indices) {
+        string file_name = graph_file(i);
+        int vertices, edges;
+        vector<int> eu, ev, ew;
+        if (min_vertices > 0 && (!read_graph_header(file_name, vertices, edges) || vertices < min_vertices)) continue;
+        if (!load_graph(file_name, vertices, edges, eu, ev, ew)) continue;
+        visit(i, "G" + to_string(i), vertices, edges, eu, ev, ew);
+    }
+}
+
+// load time of every graph with the stream reader, the mmap parser and the binary cache
+void run_load() {
+    ofstream fout("2105106_load.csv");
+    fout << "Name,|V| or n,|E| or m ,Stream (ms),Mmap (ms),Binary Cache (ms)\n";
+
+    for (int i = 1; i <= 54; i++) {
+        string file_name = graph_file(i);
+        int vertices = 0, edges = 0;
+        vector<int> eu, ev, ew;
+
+        auto start = chrono::steady_clock::now();
+        if (!load_graph_stream(file_name, vertices, edges, eu, ev, ew)) continue;
+        double stream_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        vector<int> mu, mv, mw;
+        start = chrono::steady_clock::now();
+        load_graph_mmap(file_name, vertices, edges, mu, mv, mw);
+        double mmap_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (mu != eu || mv != ev || mw != ew) cerr << "Mmap loader disagrees on " << file_name << endl;
+
+        write_binary_cache(file_name, vertices, edges, mu, mv, mw);
+        start = chrono::steady_clock::now();
+        bool cached = read_binary_cache(file_name, vertices, edges, mu, mv, mw);
+        double cache_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (!cached || mu != eu || mv != ev || mw != ew) cerr << "Binary cache disagrees on " << file_name << endl;
+
+        fout << "G" << i << "," << vertices << "," << edges << "," << stream_ms << "," << mmap_ms << "," << cache_ms << "\n";
+        cout << "G" << i << ": stream " << stream_ms << " ms, mmap " << mmap_ms << " ms, cache " << cache_ms << " ms" << endl;
+    }
+}
+
+// time budgeted GRASP on every graph, stops early once the known best value is reached
+void run_timed(double time_limit) {
+    ofstream fout("2105106_timed.csv");
+    fout << "Name,|V| or n,|E| or m ,Time Budget (s),GRASP-Iterations,GRASP-Best Value,Known Best,Time To Target (s),Elapsed (s)\n";
+    ofstream ftrace("2105106_timed_trace.csv");
+    ftrace << "Name,Time (s),Best Value\n";
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        cout << "Processing " << graph_file(i) << endl;
+
+        Graph g(vertices, edges, eu, ev, ew);
+
+        long long known = known_value(graph_id);
+
+        TimedGraspResult res = g.GRASP_timed(time_limit, known, 0.5);
+
+        fout << graph_id << "," << vertices << "," << edges << "," << time_limit << "," << res.iterations << ","
+             << res.best_cut << "," << known << "," << res.time_to_target << "," << res.elapsed << "\n";
+        for (auto &point : res.trace) {
+            ftrace << graph_id << "," << point.first << "," << point.second << "\n";
+        }
+        cout << "Graph " << i << " processed: " << res.iterations << " iterations, best " << res.best_cut << endl;
+    });
+}
+
+// GRASP with elite pool and path relinking, same iteration counts as the csv run
+void run_path_relinking() {
+    ofstream fout("2105106_pr.csv");
+    fout << "Name,|V| or n,|E| or m ,GRASP-PR-Iterations,GRASP-PR-Best Value,Known Best\n";
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        cout << "Processing " << graph_file(i) << endl;
+
+        Graph g(vertices, edges, eu, ev, ew);
+
+        int iters = vertices < 1000 ? 50 : 10;
+        auto sets = g.GRASP_path_relinking(iters, 0.5, 10);
+        long long val = g.calculate_cut_weight(sets.first, sets.second);
+
+        long long known = known_value(graph_id);
+        fout << graph_id << "," << vertices << "," << edges << "," << iters << "," << val << "," << known << "\n";
+        cout << "Graph " << i << " processed: best " << val << endl;
+    });
+}
+
+// compares the improvement phases of GRASP under the same time budget per graph
+void run_tabu(double time_limit) {
+    ofstream fout("2105106_tabu.csv");
+    fout << "Name,|V| or n,|E| or m ,Time Budget (s)";
+    vector<pair<string, ImprovementMode>> modes = {
+        {"LocalSearch", LOCAL_SEARCH}, {"Tabu", TABU_SEARCH}, {"Tabu2Flip", TABU_SEARCH_2FLIP}};
+    for (auto &m : modes) {
+        fout << "," << m.first << "-Iterations," << m.first << "-Best Value," << m.first << "-Time To Best (s)";
+    }
+    fout << ",Known Best\n";
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        cout << "Processing " << graph_file(i) << endl;
+
+        Graph g(vertices, edges, eu, ev, ew);
+
+        long long known = known_value(graph_id);
+
+        fout << graph_id << "," << vertices << "," << edges << "," << time_limit;
+        for (auto &m : modes) {
+            TimedGraspResult res = g.GRASP_timed(time_limit, known, 0.5, m.second);
+            double time_to_best = res.trace.empty() ? -1 : res.trace.back().first;
+            fout << "," << res.iterations << "," << res.best_cut << "," << time_to_best;
+            cout << "  " << m.first << ": " << res.iterations << " iterations, best " << res.best_cut
+                 << " at " << time_to_best << "s" << endl;
+        }
+        fout << "," << known << "\n";
+    });
+}
+
+// one row of 2105106.csv with the wall time of every phase
+struct CsvRow {
+    bool ok = false;
+    string name;
+    int vertices = 0, edges = 0;
+    long long randomized = 0, greedy = 0, semi_greedy = 0;
+    int local_iters = 0;
+    long long local_avg = 0;
+    int grasp_iters = 0;
+    long long grasp = 0;
+    long long known = 0;
+    double phase_seconds[5] = {0, 0, 0, 0, 0}; // randomized, greedy, semi-greedy, local search, GRASP
+};
+
+CsvRow process_graph(int i) {
+    CsvRow row;
+    string file_name = graph_file(i);
+    vector<int> eu, ev, ew;
+    if (!load_graph(file_name, row.vertices, row.edges, eu, ev, ew)) return row;
+    Graph g(row.vertices, row.edges, eu, ev, ew);
+    row.ok = true;
+    row.name = "G" + to_string(i);
+    row.known = known_value(row.name);
+
+    auto start = chrono::steady_clock::now();
+    auto lap = [&]() {
+        auto now = chrono::steady_clock::now();
+        double seconds = chrono::duration<double>(now - start).count();
+        start = now;
+        return seconds;
+    };
+
+    row.randomized = g.randomized_heuristic(10);
+    row.phase_seconds[0] = lap();
+    row.greedy = g.greedy_heuristic();
+    row.phase_seconds[1] = lap();
+    auto semi_sets = g.semi_greedy_heuristic(0.5);
+    row.semi_greedy = g.calculate_cut_weight(semi_sets.first, semi_sets.second);
+    row.phase_seconds[2] = lap();
+
+    if (row.vertices < 1000){
+        row.local_iters = 50;
+        row.grasp_iters = 50;
+    }
+    else{
+        row.local_iters = 10;
+        row.grasp_iters = 10;
+    }
+    row.local_avg = g.Local_search_for_csv(row.local_iters, 0.5); // Returns average or best
+    row.phase_seconds[3] = lap();
+
+    auto grasp_sets = g.GRASP(row.grasp_iters, 0.5);
+    row.grasp = g.calculate_cut_weight(grasp_sets.first, grasp_sets.second);
+    row.phase_seconds[4] = lap();
+    return row;
+}
+
+// bytes held by a Graph while it is being processed, dominated by the adjacency matrix
+long long estimate_graph_memory(int vertices, int edges) {
+    long long matrix = vertices <= MATRIX_MAX_VERTICES ? 4LL * (vertices + 1) * (vertices + 1) : 0;
+    return matrix + 32LL * (vertices + 1) + 40LL * edges;
+}
+
+// processes the graphs on several threads, largest first, never holding more than memory_budget
+// bytes of graphs at once (a graph larger than the budget runs alone); rows are written in graph order
+void run_csv(int threads, long long memory_budget) {
+    struct Job { int index; long long memory; };
+    vector<Job> jobs;
+    for (int i = 1; i <= 54; i++) {
+        int vertices, edges;
+        if (!read_graph_header(graph_file(i), vertices, edges)) {
+            cerr << "Cannot open " << graph_file(i) << endl;
+            continue;
+        }
+        jobs.push_back({i, estimate_graph_memory(vertices, edges)});
+    }
+    stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) { return a.memory > b.memory; });
+
+    vector<CsvRow> rows(55);
+    vector<bool> taken(jobs.size(), false);
+    mutex mtx;
+    condition_variable cv;
+    long long memory_in_use = 0;
+    int running = 0, remaining = jobs.size();
+
+    auto worker = [&]() {
+        while (true) {
+            int pick = -1;
+            {
+                unique_lock<mutex> lock(mtx);
+                cv.wait(lock, [&]() {
+                    if (remaining == 0) return true;
+                    for (int j = 0; j < (int)jobs.size(); j++) {
+                        if (!taken[j] && (running == 0 || memory_in_use + jobs[j].memory <= memory_budget)) {
+                            pick = j;
+                            return true;
+                        }
+                    }
+                    return false;
+                });
+                if (pick == -1) return;
+                taken[pick] = true;
+                remaining--;
+                running++;
+                memory_in_use += jobs[pick].memory;
+                cout << "Processing " << graph_file(jobs[pick].index) << endl;
+            }
+
+            CsvRow row = process_graph(jobs[pick].index);
+
+            {
+                lock_guard<mutex> lock(mtx);
+                rows[jobs[pick].index] = row;
+                running--;
+                memory_in_use -= jobs[pick].memory;
+                cout << "Graph " << jobs[pick].index << " processed." << endl;
+            }
+            cv.notify_all();
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 0; t < max(1, threads); t++) pool.emplace_back(worker);
+    for (auto &t : pool) t.join();
+
+    ofstream fout("2105106.csv"); // change to your student ID
+    fout << "Name,|V| or n,|E| or m ,Simple Randomized or Randomized 1,Simple Greedy or Greedy 1,Semi-Greedy 1,LocalSearch-Iterations,LocalSearch-Average value,GRASP-Iterations,GRASP-Best Value,Known Best"
+         << ",Randomized Time (s),Greedy Time (s),Semi-Greedy Time (s),LocalSearch Time (s),GRASP Time (s)\n";
+    for (auto &row : rows) {
+        if (!row.ok) continue;
+        fout << row.name << "," << row.vertices << "," << row.edges << "," << row.randomized << "," << row.greedy << ","
+             << row.semi_greedy << "," << row.local_iters << "," << row.local_avg << "," << row.grasp_iters << "," << row.grasp << "," << row.known;
+        for (double seconds : row.phase_seconds) fout << "," << seconds;
+        fout << "\n";
+    }
+    fout.close();
+}
+
+// fixed alpha = 0.5 against reactive GRASP under the same time budget per graph
+void run_reactive(double time_limit) {
+    vector<double> alphas;
+    for (int i = 0; i <= 10; i++) alphas.push_back(i / 10.0);
+
+    ofstream fout("2105106_reactive.csv");
+    fout << "Name,|V| or n,|E| or m ,Time Budget (s),GRASP-Iterations,GRASP-Best Value,Reactive-Iterations,Reactive-Best Value,Known Best";
+    for (double a : alphas) fout << ",P(alpha=" << a << ")";
+    fout << "\n";
+    ofstream falpha("2105106_reactive_alpha.csv");
+    falpha << "Name,Iteration";
+    for (double a : alphas) falpha << ",P(alpha=" << a << ")";
+    falpha << "\n";
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        cout << "Processing " << graph_file(i) << endl;
+        Graph g(vertices, edges, eu, ev, ew);
+
+        long long known = known_value(graph_id);
+
+        TimedGraspResult fixed = g.GRASP_timed(time_limit, known, 0.5);
+        ReactiveGraspResult reactive = g.GRASP_reactive(time_limit, known, alphas);
+
+        fout << graph_id << "," << vertices << "," << edges << "," << time_limit << "," << fixed.iterations << "," << fixed.best_cut
+             << "," << reactive.run.iterations << "," << reactive.run.best_cut << "," << known;
+        for (double p : reactive.probabilities) fout << "," << p;
+        fout << "\n";
+        for (auto &h : reactive.history) {
+            falpha << graph_id << "," << h.first;
+            for (double p : h.second) falpha << "," << p;
+            falpha << "\n";
+        }
+
+        cout << "  fixed alpha: " << fixed.best_cut << " in " << fixed.iterations << " iterations, reactive: "
+             << reactive.run.best_cut << " in " << reactive.run.iterations << " iterations" << endl;
+        cout << "  alpha uses:";
+        for (int a = 0; a < (int)alphas.size(); a++) cout << " " << alphas[a] << "x" << reactive.uses[a];
+        cout << endl;
+    });
+}
+
+// heap allocations and time per GRASP iteration of the Solution based loop after one warm-up iteration,
+// and of the original set based construction and local search for the graphs csv mode runs it on
+void run_alloc(int iterations) {
+    ofstream fout("2105106_alloc.csv");
+    fout << "Name,|V| or n,|E| or m ,Iterations,Allocations per Iteration,Time per Iteration (ms),"
+            "Set Based Allocations per Iteration,Set Based Time per Iteration (ms)\n";
+
+    for_each_graph([&](int, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+
+        GraspWorkspace ws;
+        g.prepare(ws);
+        g.grasp_iteration(ws, 0.5, LOCAL_SEARCH);
+        long long allocations = allocation_count.load();
+        auto start = chrono::steady_clock::now();
+        for (int k = 0; k < iterations; k++) g.grasp_iteration(ws, 0.5, LOCAL_SEARCH);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / iterations;
+        double per_iteration = double(allocation_count.load() - allocations) / iterations;
+
+        fout << graph_id << "," << vertices << "," << edges << "," << iterations << "," << per_iteration << "," << ms << ",";
+        cout << graph_id << ": " << per_iteration << " allocations, " << ms << " ms per iteration";
+
+        // the set based path is O(V^3), one measured iteration is enough to see the allocation pattern
+        if (vertices <= 1000) {
+            allocations = allocation_count.load();
+            start = chrono::steady_clock::now();
+            auto sets = g.semi_greedy_heuristic(0.5);
+            auto local_sets = g.local_search_heuristic(sets.first, sets.second);
+            g.calculate_cut_weight(local_sets.first, local_sets.second);
+            double set_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            long long set_allocations = allocation_count.load() - allocations;
+            fout << set_allocations << "," << set_ms;
+            cout << ", set based " << set_allocations << " allocations, " << set_ms << " ms";
+        }
+        else {
+            fout << ",";
+        }
+        fout << "\n";
+        cout << endl;
+    });
+}
+
+// large sample baseline of random partitions, batches * 64 samples per graph
+void run_random_distribution(int batches) {
+    ofstream fout("2105106_random.csv");
+    fout << "Name,|V| or n,|E| or m ,Samples,Mean,Stddev,Min,Max,Known Best,Time (s)\n";
+
+    for_each_graph([&](int, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+
+        auto start = chrono::steady_clock::now();
+        CutDistribution dist = g.randomized_distribution(batches);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        long long known = known_value(graph_id);
+        fout << graph_id << "," << vertices << "," << edges << "," << dist.samples << "," << dist.mean << "," << dist.stddev << ","
+             << dist.min << "," << dist.max << "," << known << "," << seconds << "\n";
+        cout << graph_id << ": mean " << dist.mean << ", stddev " << dist.stddev << ", max " << dist.max
+             << " over " << dist.samples << " samples in " << seconds << "s" << endl;
+    });
+}
+
+// checks the O(E) cut weight against the original set1 x set2 computation on every graph,
+// and the bit-parallel sampler against the O(E) cut weight
+bool run_verify_cut() {
+    bool all_equal = true;
+    for_each_graph([&](int, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+
+        vector<pair<vector<int>, vector<int>>> partitions;
+        for (int k = 0; k < 5; k++) {
+            vector<int> set1, set2;
+            for (int v = 1; v <= vertices; v++) {
+                if (rand() % 2 == 0) set1.push_back(v);
+                else set2.push_back(v);
+            }
+            partitions.push_back({set1, set2});
+        }
+        vector<int> all;
+        for (int v = 1; v <= vertices; v++) all.push_back(v);
+        partitions.push_back({all, {}});
+        partitions.push_back(g.semi_greedy_heuristic(0.5));
+
+        int mismatches = 0;
+        for (auto &p : partitions) {
+            if (g.calculate_cut_weight(p.first, p.second) != g.calculate_cut_weight_pairs(p.first, p.second)) mismatches++;
+        }
+        // every lane of the bit-parallel sampler against the edge list cut of the same partition
+        vector<uint64_t> mask(vertices + 1);
+        for (int v = 1; v <= vertices; v++) mask[v] = ((uint64_t)rand() << 33) ^ ((uint64_t)rand() << 11) ^ rand();
+        long long cuts[64];
+        g.bit_parallel_cuts(mask, cuts);
+        for (int k = 0; k < 64; k++) {
+            vector<int> set1, set2;
+            for (int v = 1; v <= vertices; v++) {
+                if ((mask[v] >> k) & 1) set2.push_back(v);
+                else set1.push_back(v);
+            }
+            if (cuts[k] != g.calculate_cut_weight(set1, set2)) mismatches++;
+        }
+
+        cout << graph_id << ": " << (mismatches == 0 ? "ok" : to_string(mismatches) + " mismatches") << endl;
+        if (mismatches > 0) all_equal = false;
+    });
+    return all_equal;
+}
+
+// checks one graph with signed or large weights, returns the number of failed checks
+int validate_graph(const string &name, int vertices, int edges, const vector<int> &eu, const vector<int> &ev, const vector<int> &ew) {
+    Graph g(vertices, edges, eu, ev, ew);
+    vector<string> failures;
+    auto check = [&](bool ok, const string &what) {
+        if (!ok) failures.push_back(what);
+    };
+    auto covers_all = [&](pair<vector<int>, vector<int>> &sets) {
+        vector<int> seen(vertices + 1, 0);
+        for (int v : sets.first) seen[v]++;
+        for (int v : sets.second) seen[v]++;
+        for (int v = 1; v <= vertices; v++) {
+            if (seen[v] != 1) return false;
+        }
+        return true;
+    };
+
+    // cut weight against the matrix scan
+    vector<char> side(vertices + 1, 0);
+    for (int v = 1; v <= vertices; v++) side[v] = rand() % 2;
+    auto sets = g.from_sides(side);
+    long long cut = g.cut_weight_sides(side);
+    check(cut == g.calculate_cut_weight_pairs(sets.first, sets.second), "edge list cut differs from matrix cut");
+
+    // incremental gains and cut after many flips
+    Solution sol, fresh;
+    g.set_solution(sol, sets.first, sets.second);
+    check(sol.cut == cut, "solution cut differs from edge list cut");
+    auto consistent = [&](const Solution &x) {
+        fresh.copy_from(x);
+        g.evaluate(fresh);
+        return x.cut == fresh.cut && x.gain == fresh.gain;
+    };
+    for (int k = 0; k < 10 * vertices; k++) g.flip(sol, 1 + rand() % vertices);
+    check(consistent(sol), "incremental cut or gains drifted after flips");
+
+    // local search ends in a 1-flip local optimum with a consistent cut
+    long long before = sol.cut;
+    g.local_search(sol);
+    check(sol.cut >= before, "local search made the cut worse");
+    check(consistent(sol), "local search state is inconsistent");
+    check(*max_element(sol.gain.begin() + 1, sol.gain.begin() + vertices + 1) <= 0, "local search stopped with an improving move");
+
+    GraspWorkspace ws;
+    g.prepare(ws);
+    before = sol.cut;
+    g.tabu_search(sol, ws, 10, vertices, true);
+    check(sol.cut >= before, "tabu search made the cut worse");
+    check(consistent(sol), "tabu search state is inconsistent");
+
+    // construction and path relinking keep the incremental state exact
+    g.construct_semi_greedy(ws.current, 0.5, ws);
+    check(consistent(ws.current), "semi-greedy construction state is inconsistent");
+    g.path_relinking(ws.current, sol, ws.relinked, ws);
+    check(consistent(ws.relinked), "path relinking state is inconsistent");
+
+    // the multilevel partition agrees with its reported cut
+    MultilevelResult ml = g.multilevel(0.05, 100);
+    check(covers_all(ml.best_sets), "multilevel partition does not cover every vertex once");
+    check(ml.best_cut == g.calculate_cut_weight(ml.best_sets.first, ml.best_sets.second), "multilevel cut is inconsistent");
+    if (ml.clamped_edges) cout << name << ": multilevel clamped " << ml.clamped_edges << " coarse edge weights to int" << endl;
+
+    // every lane of the bit-parallel sampler
+    vector<uint64_t> mask(vertices + 1);
+    for (int v = 1; v <= vertices; v++) mask[v] = ((uint64_t)rand() << 33) ^ ((uint64_t)rand() << 11) ^ rand();
+    long long cuts[64];
+    g.bit_parallel_cuts(mask, cuts);
+    for (int k = 0; k < 64; k++) {
+        for (int v = 1; v <= vertices; v++) side[v] = (mask[v] >> k) & 1;
+        if (cuts[k] != g.cut_weight_sides(side)) {
+            check(false, "bit-parallel cut differs in lane " + to_string(k));
+            break;
+        }
+    }
+
+    // the constructive heuristics still give full partitions, the semi-greedy ones are O(V^3)
+    if (vertices <= 1000) {
+        auto semi = g.semi_greedy_heuristic(0.5);
+        check(covers_all(semi), "semi-greedy partition does not cover every vertex once");
+        auto grasp = g.GRASP(1, 0.5, TABU_SEARCH);
+        check(covers_all(grasp), "GRASP partition does not cover every vertex once");
+    }
+
+    cout << name << ": " << (failures.empty() ? "ok" : "FAILED") << endl;
+    for (auto &f : failures) cout << "  " << f << endl;
+    return failures.size();
+}
+
+// validation over every G-set graph with negative weights and over synthetic large and negative weight graphs
+bool run_validate() {
+    int failed = 0;
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        if (*min_element(ew.begin(), ew.end()) < 0) {
+            failed += validate_graph(graph_id, vertices, edges, eu, ev, ew);
+        }
+
+        if (i == 1 || i == 11) {
+            // cut weights far beyond 32 bits
+            vector<int> large(ew), negative(ew), mixed(ew);
+            for (int j = 0; j < edges; j++) {
+                large[j] = 1000000 * abs(ew[j]);
+                negative[j] = -abs(ew[j]);
+                mixed[j] = (rand() % 2 ? 1 : -1) * (1000000000 + rand() % 1000000000);
+            }
+            failed += validate_graph(graph_id + " x1e6", vertices, edges, eu, ev, large);
+            failed += validate_graph(graph_id + " all negative", vertices, edges, eu, ev, negative);
+            failed += validate_graph(graph_id + " random +-1e9..2e9", vertices, edges, eu, ev, mixed);
+        }
+    });
+    cout << (failed == 0 ? "All checks passed" : to_string(failed) + " checks failed") << endl;
+    return failed == 0;
+}
+
+// first time a run reached the target, -1 if it never did
+double time_to_reach(const TimedGraspResult &run, long long target) {
+    for (auto &t : run.trace) {
+        if (t.second >= target) return t.first;
+    }
+    return -1;
+}
+
+double median(vector<double> values) {
+    if (values.empty()) return -1;
+    sort(values.begin(), values.end());
+    int n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// every algorithm on every selected graph for several seeds with the same time budget, runs are not
+// stopped at the target so the best values stay comparable, the target is reached when the cut is
+// within target_gap percent of the known best
+// per run rows go to 2105106_bench.csv and a summary per graph and algorithm to 2105106_bench.json
+void run_bench(double time_limit, int seeds, double target_gap, const vector<int> &graphs) {
+    vector<double> alphas;
+    for (int i = 0; i <= 10; i++) alphas.push_back(i / 10.0);
+    vector<string> algorithms = {"GRASP", "GRASP-Tabu", "Reactive-GRASP"};
+
+    ofstream fout("2105106_bench.csv");
+    fout << "Name,|V| or n,|E| or m ,Algorithm,Seed,Time Budget (s),Iterations,Best Value,Known Best,Gap (%),Target,Time to Target (s)\n";
+    ofstream fjson("2105106_bench.json");
+    fjson << "{\n  \"time_budget\": " << time_limit << ",\n  \"seeds\": " << seeds << ",\n  \"target_gap\": " << target_gap
+          << ",\n  \"results\": [";
+    bool first_entry = true;
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        cout << "Processing " << graph_file(i) << endl;
+        Graph g(vertices, edges, eu, ev, ew);
+
+        long long known = known_value(graph_id);
+        // without a known best there is no target and no gap
+        long long target = known > 0 ? (long long)ceil(known * (1 - target_gap / 100)) : LLONG_MAX;
+
+        for (auto &algorithm : algorithms) {
+            vector<double> best_values, gaps, times_to_target, iteration_rates;
+            for (int seed = 1; seed <= seeds; seed++) {
+                g.seed(seed);
+                TimedGraspResult run;
+                if (algorithm == "GRASP") run = g.GRASP_timed(time_limit, 0, 0.5);
+                else if (algorithm == "GRASP-Tabu") run = g.GRASP_timed(time_limit, 0, 0.5, TABU_SEARCH);
+                else run = g.GRASP_reactive(time_limit, 0, alphas).run;
+
+                double gap = known > 0 ? 100.0 * (known - run.best_cut) / known : 0;
+                double ttt = time_to_reach(run, target);
+                best_values.push_back(run.best_cut);
+                if (known > 0) gaps.push_back(gap);
+                if (ttt >= 0) times_to_target.push_back(ttt);
+                iteration_rates.push_back(run.iterations / run.elapsed);
+
+                fout << graph_id << "," << vertices << "," << edges << "," << algorithm << "," << seed << "," << time_limit << ","
+                     << run.iterations << "," << run.best_cut << "," << (known > 0 ? to_string(known) : "") << ",";
+                if (known > 0) fout << gap;
+                fout << "," << (known > 0 ? to_string(target) : "") << "," << (ttt >= 0 ? to_string(ttt) : "") << "\n";
+            }
+
+            double mean = 0;
+            for (double b : best_values) mean += b;
+            mean /= best_values.size();
+            double stddev = 0;
+            for (double b : best_values) stddev += (b - mean) * (b - mean);
+            stddev = sqrt(stddev / best_values.size());
+
+            // graphs without a known best have no gap and no target, null in the json and n/a on the console
+            string gap_json = "null", gap_text = "n/a", target_text = "no target";
+            if (known > 0) {
+                ostringstream json, text;
+                json << "{\"min\": " << *min_element(gaps.begin(), gaps.end()) << ", \"median\": " << median(gaps)
+                     << ", \"max\": " << *max_element(gaps.begin(), gaps.end()) << "}";
+                text << median(gaps) << "%";
+                gap_json = json.str();
+                gap_text = text.str();
+                target_text = "target hit in " + to_string(times_to_target.size()) + "/" + to_string(seeds) + " runs";
+            }
+
+            fjson << (first_entry ? "\n" : ",\n") << "    {\"graph\": \"" << graph_id << "\", \"vertices\": " << vertices
+                  << ", \"edges\": " << edges << ", \"algorithm\": \"" << algorithm << "\", \"known_best\": "
+                  << (known > 0 ? to_string(known) : "null") << ", \"best\": {\"min\": " << *min_element(best_values.begin(), best_values.end())
+                  << ", \"median\": " << median(best_values) << ", \"mean\": " << mean << ", \"stddev\": " << stddev
+                  << ", \"max\": " << *max_element(best_values.begin(), best_values.end()) << "}"
+                  << ", \"gap_percent\": " << gap_json
+                  << ", \"target_hits\": " << (known > 0 ? to_string(times_to_target.size()) : "null") << ", \"median_time_to_target\": "
+                  << (times_to_target.empty() ? "null" : to_string(median(times_to_target)))
+                  << ", \"iterations_per_second\": " << median(iteration_rates) << "}";
+            first_entry = false;
+
+            cout << "  " << algorithm << ": best " << *max_element(best_values.begin(), best_values.end()) << ", median "
+                 << median(best_values) << ", median gap " << gap_text << ", " << target_text << endl;
+        }
+    }, graphs);
+    fjson << "\n  ]\n}\n";
+}
+
+// multilevel solver against flat GRASP with the same time budget, on the G-set graphs or on one random
+// sparse graph with unit weights when synthetic_vertices > 0, flat GRASP is skipped on graphs too large
+// for a single O(V^2) construction to finish in the budget
+void run_multilevel(double time_limit, int synthetic_vertices, long long synthetic_edges) {
+    ofstream fout("2105106_multilevel.csv");
+    fout << "Name,|V| or n,|E| or m ,Time Budget (s),Levels,Coarsest |V|,Coarsening (s),V-Cycles,Multilevel-Best Value,"
+            "GRASP-Iterations,GRASP-Best Value,Known Best,Clamped Coarse Edges\n";
+
+    auto solve = [&](const string &graph_id, int vertices, int edges, const vector<int> &eu, const vector<int> &ev, const vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+        MultilevelResult ml = g.multilevel(time_limit);
+        long long known = known_value(graph_id);
+
+        fout << graph_id << "," << vertices << "," << edges << "," << time_limit << "," << ml.levels << "," << ml.coarsest_vertices << ","
+             << ml.coarsen_seconds << "," << ml.cycles << "," << ml.best_cut << ",";
+        cout << graph_id << ": multilevel " << ml.best_cut << " with " << ml.levels << " levels down to " << ml.coarsest_vertices
+             << " vertices, " << ml.cycles << " V-cycles";
+        if (vertices <= 20000) {
+            TimedGraspResult flat = g.GRASP_timed(time_limit, 0, 0.5);
+            fout << flat.iterations << "," << flat.best_cut;
+            cout << ", flat GRASP " << flat.best_cut << " in " << flat.iterations << " iterations";
+        }
+        else {
+            fout << ",";
+        }
+        fout << "," << known << "," << ml.clamped_edges << "\n";
+        if (ml.clamped_edges) cout << ", " << ml.clamped_edges << " coarse edge weights clamped to int";
+        cout << endl;
+    };
+
+    if (synthetic_vertices > 0) {
+        int vertices = synthetic_vertices;
+        int edges = synthetic_edges;
+        vector<int> eu(edges), ev(edges), ew(edges, 1);
+        mt19937 gen(rand());
+        for (int j = 0; j < edges; j++) {
+            eu[j] = 1 + gen() % vertices;
+            do {
+                ev[j] = 1 + gen() % vertices;
+            } while (ev[j] == eu[j]);
+        }
+        solve("Random", vertices, edges, eu, ev, ew);
+        return;
+    }
+
+    for_each_graph([&](int, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        solve(graph_id, vertices, edges, eu, ev, ew);
+    });
+}
+
+// --- GRASP over several processes ---
+
+// message between the coordinator and a worker: a partition as packed bits and its cut weight
+enum MessageType { WORKER_BEST = 1, ELITE = 2, WORKER_DONE = 3 };
+
+struct MessageHeader {
+    int type;
+    int words;
+    long long cut;
+    long long iterations;
+};
+
+bool write_all(int fd, const void *data, size_t size) {
+    const char *p = (const char *)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool read_all(int fd, void *data, size_t size) {
+    char *p = (char *)data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool send_solution(int fd, int type, const Solution &s, long long iterations) {
+    MessageHeader header = {type, (int)s.bits.size(), s.cut, iterations};
+    return write_all(fd, &header, sizeof(header)) && write_all(fd, s.bits.data(), s.bits.size() * sizeof(uint64_t));
+}
+
+// reads one message into s.bits, the caller evaluates the partition if it needs the gains
+bool receive_solution(int fd, MessageHeader &header, Solution &s) {
+    if (!read_all(fd, &header, sizeof(header)) || header.words != (int)s.bits.size()) return false;
+    return read_all(fd, s.bits.data(), header.words * sizeof(uint64_t));
+}
+
+// worker process: GRASP with path relinking, its best partition goes to the coordinator every interval seconds
+// and the elites the coordinator sends back join the local elite pool
+void distributed_worker(Graph &g, int fd, double time_limit, double interval) {
+    int vertices = g.vertex_count();
+    GraspWorkspace ws;
+    g.prepare(ws);
+    ElitePool pool(10, max(1, vertices / 100), vertices);
+    Solution incoming;
+    incoming.resize(vertices);
+
+    auto start = chrono::steady_clock::now();
+    auto elapsed_seconds = [&]() {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+    double next_report = interval;
+    long long iterations = 0;
+    long long reported = LLONG_MIN;
+
+    while (elapsed_seconds() < time_limit) {
+        g.path_relinking_iteration(ws, pool, 0.5);
+        iterations++;
+
+        pollfd pfd = {fd, POLLIN, 0};
+        while (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+            MessageHeader header;
+            if (!receive_solution(fd, header, incoming)) return;
+            g.evaluate(incoming);
+            pool.try_add(incoming);
+        }
+
+        if (elapsed_seconds() >= next_report) {
+            if (ws.best.cut > reported) {
+                if (!send_solution(fd, WORKER_BEST, ws.best, iterations)) return;
+                reported = ws.best.cut;
+            }
+            next_report += interval;
+        }
+    }
+    send_solution(fd, WORKER_DONE, ws.best, iterations);
+}
+
+struct DistributedResult {
+    long long best_cut = LLONG_MIN;
+    int best_worker = -1;
+    long long iterations = 0;
+    int reports = 0, broadcasts = 0;
+    bool consistent = true;
+    double elapsed = 0;
+};
+
+// forks the workers, each one talks to the coordinator over its own Unix socket pair, the coordinator keeps
+// the best partition reported so far and sends every improvement to all the other workers as an elite
+DistributedResult run_distributed_graph(Graph &g, int workers, double time_limit, double interval) {
+    DistributedResult result;
+    auto start = chrono::steady_clock::now();
+    cout.flush();
+
+    vector<int> fds;
+    vector<pid_t> pids;
+    for (int w = 0; w < workers; w++) {
+        int pair_fd[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair_fd) < 0) {
+            cerr << "Cannot create socket pair" << endl;
+            break;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Cannot fork worker" << endl;
+            close(pair_fd[0]);
+            close(pair_fd[1]);
+            break;
+        }
+        if (pid == 0) {
+            close(pair_fd[0]);
+            for (int fd : fds) close(fd);
+            g.seed(1000003u * (w + 1) + getpid());
+            distributed_worker(g, pair_fd[1], time_limit, interval);
+            close(pair_fd[1]);
+            _exit(0);
+        }
+        close(pair_fd[1]);
+        fds.push_back(pair_fd[0]);
+        pids.push_back(pid);
+    }
+
+    int vertices = g.vertex_count();
+    Solution best, incoming;
+    best.resize(vertices);
+    incoming.resize(vertices);
+    vector<bool> open_fd(fds.size(), true);
+    int open_count = fds.size();
+
+    while (open_count > 0) {
+        vector<pollfd> pfds;
+        vector<int> index;
+        for (int w = 0; w < (int)fds.size(); w++) {
+            if (!open_fd[w]) continue;
+            pfds.push_back({fds[w], POLLIN, 0});
+            index.push_back(w);
+        }
+        if (poll(pfds.data(), pfds.size(), 1000) <= 0) continue;
+
+        for (int k = 0; k < (int)pfds.size(); k++) {
+            if (!(pfds[k].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            int w = index[k];
+            MessageHeader header;
+            if (!receive_solution(fds[w], header, incoming)) {
+                open_fd[w] = false;
+                open_count--;
+                continue;
+            }
+            result.reports++;
+            if (header.type == WORKER_DONE) {
+                result.iterations += header.iterations;
+                open_fd[w] = false;
+                open_count--;
+            }
+            if (header.cut > result.best_cut) {
+                result.best_cut = header.cut;
+                result.best_worker = w;
+                best.bits = incoming.bits;
+                best.cut = header.cut;
+                // --- broadcast the new elite ---
+                for (int other = 0; other < (int)fds.size(); other++) {
+                    if (other == w || !open_fd[other]) continue;
+                    if (send_solution(fds[other], ELITE, best, 0)) result.broadcasts++;
+                }
+            }
+        }
+    }
+
+    for (int fd : fds) close(fd);
+    for (pid_t pid : pids) waitpid(pid, nullptr, 0);
+
+    // the reported cut has to be the cut of the partition that came with it
+    if (result.best_worker >= 0) {
+        long long cut = best.cut;
+        g.evaluate(best);
+        result.consistent = best.cut == cut;
+    }
+    result.elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// GRASP with path relinking on several worker processes against one process with the same time budget
+void run_distributed(int workers, double time_limit, double interval) {
+    signal(SIGPIPE, SIG_IGN);
+    ofstream fout("2105106_distributed.csv");
+    fout << "Name,|V| or n,|E| or m ,Workers,Time Budget (s),Exchange Interval (s),Distributed-Iterations,Distributed-Best Value,"
+            "Reports,Broadcasts,Single-Iterations,Single-Best Value,Known Best\n";
+
+    for_each_graph([&](int, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+        long long known = known_value(graph_id);
+
+        DistributedResult dist = run_distributed_graph(g, workers, time_limit, interval);
+        if (!dist.consistent) cerr << graph_id << ": reported cut does not match the partition" << endl;
+        DistributedResult single = run_distributed_graph(g, 1, time_limit, interval);
+
+        fout << graph_id << "," << vertices << "," << edges << "," << workers << "," << time_limit << "," << interval << ","
+             << dist.iterations << "," << dist.best_cut << "," << dist.reports << "," << dist.broadcasts << "," << single.iterations << ","
+             << single.best_cut << "," << known << "\n";
+        cout << graph_id << ": " << workers << " workers " << dist.best_cut << " in " << dist.iterations << " iterations ("
+             << dist.reports << " reports, " << dist.broadcasts << " elites sent), 1 worker " << single.best_cut << " in "
+             << single.iterations << " iterations" << endl;
+    });
+}
+
+// hardware cache miss counter of this thread, not every machine or container allows perf events
+struct CacheMissCounter {
+    int fd = -1;
+
+    bool start() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) return false;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        return true;
+    }
+
+    // -1 when the counter could not be opened
+    long long stop() {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long misses = -1;
+        if (read(fd, &misses, sizeof(misses)) != sizeof(misses)) misses = -1;
+        close(fd);
+        fd = -1;
+        return misses;
+    }
+};
+
+// local search throughput and cache misses of the graphs with at least 2000 vertices in file order and
+// with every reordering, GRASP iterations and queue local search from random partitions run for time_limit each
+void run_reorder(double time_limit) {
+    vector<string> methods = {"none", "bfs", "rcm", "degree"};
+    ofstream fout("2105106_reorder.csv");
+    fout << "Name,|V| or n,|E| or m ,Order,Average Edge Span,GRASP Iterations per Second,GRASP Cache Misses per Iteration,"
+            "Refined Random Partitions per Second,Refine Cache Misses per Partition\n";
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        cout << "Processing " << graph_file(i) << endl;
+
+        for (auto &method : methods) {
+            vector<int> ru(eu), rv(ev);
+            VertexOrder order;
+            bool reordered = reorder_graph(vertices, edges, ru, rv, method, order);
+            Graph g(vertices, edges, ru, rv, ew);
+            g.seed(i);
+
+            // --- GRASP iterations ---
+            GraspWorkspace ws;
+            g.prepare(ws);
+            CacheMissCounter counter;
+            counter.start();
+            auto start = chrono::steady_clock::now();
+            long long iterations = 0;
+            double seconds = 0;
+            while (seconds < time_limit) {
+                g.grasp_iteration(ws, 0.5, LOCAL_SEARCH);
+                iterations++;
+                seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            }
+            long long grasp_misses = counter.stop();
+
+            // the best partition mapped back to the file labels has the same cut on the original graph
+            if (reordered) {
+                Graph original(vertices, edges, eu, ev, ew);
+                auto sets = to_original_ids(g.solution_sets(ws.best), order);
+                if (original.calculate_cut_weight(sets.first, sets.second) != ws.best.cut) {
+                    cerr << graph_id << " " << method << ": cut changes after mapping back to original labels" << endl;
+                }
+            }
+
+            // --- local search from random partitions ---
+            Solution s;
+            s.resize(vertices);
+            mt19937 gen(i);
+            counter.start();
+            start = chrono::steady_clock::now();
+            long long refined = 0;
+            double refine_seconds = 0;
+            while (refine_seconds < time_limit) {
+                for (auto &word : s.bits) word = ((uint64_t)gen() << 32) ^ gen();
+                g.evaluate(s);
+                g.local_search_queue(s);
+                refined++;
+                refine_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            }
+            long long refine_misses = counter.stop();
+
+            double span = average_edge_span(edges, ru, rv);
+            fout << graph_id << "," << vertices << "," << edges << "," << method << "," << span << "," << iterations / seconds << ",";
+            if (grasp_misses >= 0) fout << (double)grasp_misses / iterations;
+            fout << "," << refined / refine_seconds << ",";
+            if (refine_misses >= 0) fout << (double)refine_misses / refined;
+            fout << "\n";
+
+            cout << "  " << method << ": span " << span << ", " << iterations / seconds << " GRASP iterations/s, " << refined / refine_seconds
+                 << " refined partitions/s, cache misses ";
+            if (grasp_misses >= 0) cout << (double)grasp_misses / iterations << " per iteration, " << (double)refine_misses / refined << " per refine";
+            else cout << "n/a";
+            cout << endl;
+        }
+    }, {}, 2000);
+}
+
+// greedy and semi-greedy heuristics with every sigma kernel, the kernels must give the same partitions for the
+// same seed, the scan kernel is O(V^3) and only runs on graphs with at most 1000 vertices
+void run_dense(int repeats) {
+    ofstream fout("2105106_dense.csv");
+    fout << "Name,|V| or n,|E| or m ,Density,Auto Kernel,AVX2,Scan Greedy (ms),Sparse Greedy (ms),Dense Greedy (ms),"
+            "Scan Semi-greedy (ms),Sparse Semi-greedy (ms),Dense Semi-greedy (ms),Same Results\n";
+
+    for_each_graph([&](int, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+
+        vector<SigmaKernel> kernels = {KERNEL_SCAN, KERNEL_SPARSE, KERNEL_DENSE};
+        double greedy_ms[3] = {-1, -1, -1}, semi_ms[3] = {-1, -1, -1};
+        double greedy_cut[3];
+        pair<vector<int>, vector<int>> semi_sets[3];
+        bool same = true;
+        for (int k = 0; k < 3; k++) {
+            if (kernels[k] == KERNEL_SCAN && vertices > 1000) continue;
+            auto start = chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++) greedy_cut[k] = g.greedy_heuristic(kernels[k]);
+            greedy_ms[k] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeats;
+
+            start = chrono::steady_clock::now();
+            for (int r = 0; r < repeats; r++) {
+                g.seed(r);
+                semi_sets[k] = g.semi_greedy_heuristic(0.5, kernels[k]);
+            }
+            semi_ms[k] = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repeats;
+
+            int reference = greedy_ms[0] >= 0 ? 0 : 1;
+            if (k > reference) same = same && greedy_cut[k] == greedy_cut[reference] && semi_sets[k] == semi_sets[reference];
+        }
+
+        string automatic = g.resolve_kernel(KERNEL_AUTO) == KERNEL_DENSE ? "dense" : "sparse";
+        fout << graph_id << "," << vertices << "," << edges << "," << g.density() << "," << automatic << "," << cpu_has_avx2();
+        for (double ms : greedy_ms) fout << "," << (ms >= 0 ? to_string(ms) : "");
+        for (double ms : semi_ms) fout << "," << (ms >= 0 ? to_string(ms) : "");
+        fout << "," << (same ? "yes" : "no") << "\n";
+
+        cout << graph_id << " density " << g.density() << " (" << automatic << "): greedy";
+        for (double ms : greedy_ms) cout << " " << (ms >= 0 ? to_string(ms) : "-");
+        cout << " ms, semi-greedy";
+        for (double ms : semi_ms) cout << " " << (ms >= 0 ? to_string(ms) : "-");
+        cout << " ms (scan sparse dense)" << (same ? "" : ", KERNELS DISAGREE") << endl;
+    });
+}
+
+// random edge changes on every graph: half of the changes remove an existing edge and half insert a new one
+// with the weight of a random existing edge, after each step the previous best partition is repaired by
+// apply_edge_deltas and resolve, and compared with a full rebuild and GRASP run of the same length
+void run_incremental(int deltas_per_step, int steps, int iterations) {
+    ofstream fout("2105106_incremental.csv");
+    fout << "Name,|V| or n,|E| or m ,Step,Edge Changes,Update (ms),Warm Start Cut,Full Re-run (ms),Full Re-run Cut,Consistent\n";
+
+    for_each_graph([&](int i, const string &graph_id, int vertices, int edges, vector<int> &eu, vector<int> &ev, vector<int> &ew) {
+        Graph g(vertices, edges, eu, ev, ew);
+        cout << "Processing " << graph_file(i) << endl;
+
+        GraspWorkspace ws;
+        g.prepare(ws);
+        for (int k = 0; k < iterations; k++) g.grasp_iteration(ws, 0.5, LOCAL_SEARCH);
+        Solution &s = ws.best;
+        Solution fresh;
+        mt19937 gen(i);
+
+        for (int step = 1; step <= steps; step++) {
+            vector<EdgeDelta> deltas;
+            g.edge_list(eu, ev, ew);
+            for (int k = 0; k < deltas_per_step; k++) {
+                int j = gen() % eu.size();
+                if (k % 2 == 0) deltas.push_back({eu[j], ev[j], 0});
+                else deltas.push_back({1 + (int)(gen() % vertices), 1 + (int)(gen() % vertices), ew[j]});
+            }
+
+            auto start = chrono::steady_clock::now();
+            vector<int> changed;
+            g.apply_edge_deltas(deltas, s, changed);
+            g.resolve(s, changed);
+            double update_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            fresh.copy_from(s);
+            g.evaluate(fresh);
+            bool consistent = fresh.cut == s.cut && fresh.gain == s.gain;
+
+            start = chrono::steady_clock::now();
+            g.edge_list(eu, ev, ew);
+            Graph rebuilt(vertices, eu.size(), eu, ev, ew);
+            auto sets = rebuilt.GRASP(iterations, 0.5);
+            long long full_cut = rebuilt.calculate_cut_weight(sets.first, sets.second);
+            double full_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+            fout << graph_id << "," << vertices << "," << eu.size() << "," << step << "," << changed.size() / 2 << "," << update_ms << ","
+                 << s.cut << "," << full_ms << "," << full_cut << "," << (consistent ? "yes" : "no") << "\n";
+            cout << "  step " << step << ": warm start " << s.cut << " in " << update_ms << " ms, full re-run " << full_cut << " in "
+                 << full_ms << " ms" << (consistent ? "" : ", INCONSISTENT GAINS") << endl;
+        }
+    });
+}
+
+int main(int argc, char *argv[]) {
+    srand(time(0)); // seed randomness
+
+    // --cache and --reorder=<bfs|rcm|degree> can be given anywhere, the other arguments are positional
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--cache") use_binary_cache = true;
+        else if (string(argv[i]).rfind("--reorder=", 0) == 0) reorder_method = string(argv[i]).substr(10);
+        else args.push_back(argv[i]);
+    }
+
+    string mode = "csv";
+    if (args.size() > 0) {
+        mode = args[0];
+    }
+    if (mode == "timed") {
+        double time_limit = 10;
+        if (args.size() > 1) time_limit = stod(args[1]);
+        run_timed(time_limit);
+        return 0;
+    }
+    else if (mode == "tabu") {
+        double time_limit = 10;
+        if (args.size() > 1) time_limit = stod(args[1]);
+        run_tabu(time_limit);
+        return 0;
+    }
+    else if (mode == "pr") {
+        run_path_relinking();
+        return 0;
+    }
+    else if (mode == "load") {
+        run_load();
+        return 0;
+    }
+    else if (mode == "reactive") {
+        double time_limit = 10;
+        if (args.size() > 1) time_limit = stod(args[1]);
+        run_reactive(time_limit);
+        return 0;
+    }
+    else if (mode == "bench") {
+        double time_limit = 1;
+        int seeds = 5;
+        double target_gap = 1;
+        vector<int> graphs;
+        if (args.size() > 1) time_limit = stod(args[1]);
+        if (args.size() > 2) seeds = stoi(args[2]);
+        if (args.size() > 3) target_gap = stod(args[3]);
+        if (time_limit <= 0 || seeds < 1) {
+            cerr << "bench needs a positive time limit and at least one seed" << endl;
+            return 1;
+        }
+        // graph numbers separated by commas, all of them by default
+        if (args.size() > 4) {
+            stringstream list(args[4]);
+            string id;
+            while (getline(list, id, ',')) graphs.push_back(stoi(id));
+        }
+        run_bench(time_limit, seeds, target_gap, graphs);
+        return 0;
+    }
+    else if (mode == "multilevel") {
+        double time_limit = 10;
+        int synthetic_vertices = 0;
+        long long synthetic_edges = 0;
+        if (args.size() > 1) time_limit = stod(args[1]);
+        if (args.size() > 3) {
+            synthetic_vertices = stoi(args[2]);
+            synthetic_edges = stoll(args[3]);
+        }
+        run_multilevel(time_limit, synthetic_vertices, synthetic_edges);
+        return 0;
+    }
+    else if (mode == "distributed") {
+        int workers = thread::hardware_concurrency();
+        double time_limit = 10;
+        double interval = 0.5;
+        if (args.size() > 1) workers = stoi(args[1]);
+        if (args.size() > 2) time_limit = stod(args[2]);
+        if (args.size() > 3) interval = stod(args[3]);
+        run_distributed(workers, time_limit, interval);
+        return 0;
+    }
+    else if (mode == "reorder") {
+        double time_limit = 2;
+        if (args.size() > 1) time_limit = stod(args[1]);
+        run_reorder(time_limit);
+        return 0;
+    }
+    else if (mode == "dense") {
+        int repeats = 3;
+        if (args.size() > 1) repeats = stoi(args[1]);
+        run_dense(repeats);
+        return 0;
+    }
+    else if (mode == "incremental") {
+        int deltas_per_step = 10, steps = 5, iterations = 20;
+        if (args.size() > 1) deltas_per_step = stoi(args[1]);
+        if (args.size() > 2) steps = stoi(args[2]);
+        if (args.size() > 3) iterations = stoi(args[3]);
+        run_incremental(deltas_per_step, steps, iterations);
+        return 0;
+    }
+    else if (mode == "alloc") {
+#ifndef COUNT_ALLOCATIONS
+        cerr << "alloc needs a build with -DCOUNT_ALLOCATIONS" << endl;
+        return 1;
+#endif
+        int iterations = 20;
+        if (args.size() > 1) iterations = stoi(args[1]);
+        run_alloc(iterations);
+        return 0;
+    }
+    else if (mode == "random") {
+        int batches = 1000;
+        if (args.size() > 1) batches = stoi(args[1]);
+        run_random_distribution(batches);
+        return 0;
+    }
+    else if (mode == "validate") {
+        return run_validate() ? 0 : 1;
+    }
+    else if (mode == "verify") {
+        return run_verify_cut() ? 0 : 1;
+    }
+    else if (mode == "parallel") {
+        int threads = thread::hardware_concurrency();
+        long long memory_mb = 1024;
+        if (args.size() > 1) threads = stoi(args[1]);
+        if (args.size() > 2) memory_mb = stoll(args[2]);
+        run_csv(threads, memory_mb * 1024 * 1024);
+        return 0;
+    }
+    else if (mode != "csv") {
+        cout << "Invalid mode. Defaulting to csv." << endl;
+    }
+
+    run_csv(1, LLONG_MAX);
+    return 0;
+}
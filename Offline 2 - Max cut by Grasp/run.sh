@@ -1,2 +1,23 @@
 g++ 2105106_main.cpp -o 2105106_main.o
-./2105106_main.o
\ No newline at end of file
+./2105106_main.o
+
+
+# csv
+# timed <seconds per graph>
+# pr
+# tabu <seconds per graph>
+# load
+# add --cache to any mode to reuse input_graphs/g*.rud.bin
+# add --reorder=<bfs|rcm|degree> to any mode to renumber the vertices at load time
+# parallel <threads> <memory budget MB>
+# reactive <seconds per graph>
+# random <batches of 64 partitions>
+# verify
+# validate
+# alloc <iterations> (build with -DCOUNT_ALLOCATIONS)
+# bench <seconds per run> <seeds> <target gap %> <graphs, e.g. 1,11,32>
+# multilevel <seconds per graph> [random graph vertices] [random graph edges]
+# distributed <worker processes> <seconds per graph> <exchange interval seconds>
+# reorder <seconds per measurement>
+# dense <repeats>
+# incremental <edge changes per step> <steps> <GRASP iterations>
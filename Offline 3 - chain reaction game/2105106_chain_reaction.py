@@ -1,10 +1,20 @@
 import tkinter as tk
 from tkinter import messagebox
+import atexit
+import os
+import subprocess
+import sys
 
 ROWS, COLS = 9, 6
 CELL_SIZE = 60
 DELAY = 1000  # milliseconds between chain reactions
 
+# the engine is started as a child and asked for moves over its stdin/stdout line protocol,
+# run with --file to talk to a separately started engine through gamestate.txt instead
+USE_PIPE = "--file" not in sys.argv
+ENGINE_COMMAND = ["./2105106_engine", "pipe", "--time=1000", "--ponder"]
+engine = None
+
 # Game state
 BOARD = [['0' for _ in range(COLS)] for _ in range(ROWS)]
 PLAYER = 'R'  # R = Red, B = Blue
@@ -167,12 +177,72 @@ def on_mode_change(*args):
 
 
 def write_gamestate_to_file(player):
-    with open("gamestate.txt", "w") as f:
+    # renamed over gamestate.txt so the engine never reads half a board
+    with open("gamestate.txt.tmp", "w") as f:
         header = "Human Move:" if player == "R" else "AI Move:"
         f.write(f"{header}\n")
         for row in BOARD:
             row_str = " ".join(cell for cell in row)
             f.write(f"{row_str}\n")
+    os.replace("gamestate.txt.tmp", "gamestate.txt")
+
+
+def start_engine():
+    global engine
+    if engine is None or engine.poll() is not None:
+        try:
+            engine = subprocess.Popen(ENGINE_COMMAND, stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1)
+        except OSError as e:
+            print("Cannot start engine:", e)
+            engine = None
+    return engine
+
+
+def stop_engine():
+    if engine is not None and engine.poll() is None:
+        engine.stdin.write("quit\n")
+        engine.stdin.flush()
+        engine.wait()
+
+atexit.register(stop_engine)
+
+
+def ask_engine_for_move():
+    """sends the board to the engine, returns (row, col) of its move or None if the engine failed"""
+    proc = start_engine()
+    if proc is None:
+        return None
+    cells = " ".join(cell for row in BOARD for cell in row)
+    start = time.perf_counter()
+    try:
+        proc.stdin.write(f"go {cells}\n")
+        proc.stdin.flush()
+        reply = proc.stdout.readline().split()
+    except OSError as e:
+        print("Engine error:", e)
+        return None
+    round_trip = (time.perf_counter() - start) * 1000
+    if len(reply) < 7 or reply[0] != "bestmove":
+        print("Unexpected engine reply:", " ".join(reply))
+        return None
+    print(f"AI move {reply[1]}, {reply[2]}: depth {reply[4]}, search {float(reply[6]):.1f} ms, round trip {round_trip:.1f} ms")
+    return int(reply[1]), int(reply[2])
+
+
+def apply_engine_move():
+    move = ask_engine_for_move()
+    if move is None:
+        # fall back to an engine running in file mode
+        write_gamestate_to_file('R')
+        wait_for_ai_and_apply_move()
+        return
+    i, j = move
+    if i == -1:
+        print("Engine has no move!")
+        return
+    add_orb(i, j, 'B')
+    process_explosions()
+    draw_board()
 
 import time
 
@@ -185,13 +255,19 @@ def finish_turn():
     else:
         if GAME_MODE.get() == "Human vs AI" and PLAYER == "R":
             draw_board()  # Ensure human move is drawn
-            write_gamestate_to_file(PLAYER)
-            PLAYER = 'B'
-            update_status_label()
-            root.after(100, wait_for_ai_and_apply_move)  # slight delay to allow UI update
+            if USE_PIPE:
+                PLAYER = 'B'
+                update_status_label()
+                root.after(1, apply_engine_move)  # let the UI update first
+            else:
+                write_gamestate_to_file(PLAYER)
+                PLAYER = 'B'
+                update_status_label()
+                root.after(100, wait_for_ai_and_apply_move)  # slight delay to allow UI update
         elif GAME_MODE.get() == "Human vs AI" and PLAYER == "B":
             # print("ekhane asche ")
-            write_gamestate_to_file(PLAYER)
+            if not USE_PIPE:
+                write_gamestate_to_file(PLAYER)
             PLAYER = 'R'
             update_status_label()
         else:
@@ -7,6 +7,17 @@
 #include <climits>
 #include <queue>
 #include <utility>
+#include <cstdint>
+#include <random>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cmath>
+#include <csignal>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using namespace std;
 
@@ -30,14 +41,17 @@ bool read_human_move(const string& filename) {
     getline(fin, header);
     if (header != "Human Move:") return false;
 
+    // a file caught halfway through being written is left for the next poll
+    vector<vector<string>> state(ROWS, vector<string>(COLS, "0"));
     for (int i = 0; i < ROWS; ++i) {
         string line;
-        getline(fin, line);
+        if (!getline(fin, line)) return false;
         istringstream ss(line);
         for (int j = 0; j < COLS; ++j) {
-            ss >> board[i][j];
+            if (!(ss >> state[i][j])) return false;
         }
     }
+    board = state;
 
     cout << "Human move received.\n";
     return true;
@@ -50,6 +64,219 @@ int critical_mass(int i, int j) {
     return 4;
 }
 
+// --- Compact board ---
+// one byte per cell, the orb count in the low 7 bits and the owner in the top bit (set for blue),
+// an empty cell is 0; the text board is only used when reading and writing gamestate.txt
+const int CELLS = ROWS * COLS;
+const uint8_t BLUE_BIT = 0x80;
+const uint8_t COUNT_MASK = 0x7f;
+
+struct Board {
+    uint8_t cells[CELLS];
+    uint8_t owned[2]; // number of cells of red and of blue
+    uint64_t hash;    // zobrist key of the cells
+};
+
+// per cell critical mass and neighbours (up, down, left, right, as in applyAction)
+int CRITICAL[CELLS];
+int NEIGHBOR_COUNT[CELLS];
+int NEIGHBORS[CELLS][4];
+
+// zobrist keys indexed by cell and cell byte (owner bit and count), the empty cell has key 0 so the
+// hash only changes for the cells a move touches
+uint64_t ZOBRIST[CELLS][256];
+uint64_t ZOBRIST_SIDE; // xored in when the AI is to move
+
+void init_tables() {
+    mt19937_64 gen(106);
+    for (int c = 0; c < CELLS; c++) {
+        ZOBRIST[c][0] = 0;
+        for (int v = 1; v < 256; v++) ZOBRIST[c][v] = gen();
+    }
+    ZOBRIST_SIDE = gen();
+
+    int dx[] = {-1, 1, 0, 0};
+    int dy[] = {0, 0, -1, 1};
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLS; j++) {
+            int c = i * COLS + j;
+            CRITICAL[c] = critical_mass(i, j);
+            NEIGHBOR_COUNT[c] = 0;
+            for (int k = 0; k < 4; k++) {
+                int ni = i + dx[k], nj = j + dy[k];
+                if (ni >= 0 && ni < ROWS && nj >= 0 && nj < COLS) NEIGHBORS[c][NEIGHBOR_COUNT[c]++] = ni * COLS + nj;
+            }
+        }
+    }
+}
+
+inline uint8_t owner_bit(char player) {
+    return player == 'B' ? BLUE_BIT : 0;
+}
+
+inline int orbs(uint8_t cell) {
+    return cell & COUNT_MASK;
+}
+
+inline bool owned_by(uint8_t cell, char player) {
+    return cell != 0 && (cell & BLUE_BIT) == owner_bit(player);
+}
+
+// index of the owner of a non-empty cell in Board::owned
+inline int owner_index(uint8_t cell) {
+    return cell >> 7;
+}
+
+// owner counts and hash recomputed from the cells
+void refresh_board(Board& b) {
+    b.owned[0] = b.owned[1] = 0;
+    b.hash = 0;
+    for (int c = 0; c < CELLS; c++) {
+        if (b.cells[c]) b.owned[owner_index(b.cells[c])]++;
+        b.hash ^= ZOBRIST[c][b.cells[c]];
+    }
+}
+
+Board to_board(const vector<vector<string>>& state) {
+    Board b;
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLS; j++) {
+            const string& val = state[i][j];
+            uint8_t cell = 0;
+            if (val != "0" && !val.empty()) cell = stoi(val.substr(0, val.size() - 1)) | owner_bit(val.back());
+            b.cells[i * COLS + j] = cell;
+        }
+    }
+    refresh_board(b);
+    return b;
+}
+
+vector<vector<string>> to_text(const Board& b) {
+    vector<vector<string>> state(ROWS, vector<string>(COLS, "0"));
+    for (int c = 0; c < CELLS; c++) {
+        if (b.cells[c]) state[c / COLS][c % COLS] = to_string(orbs(b.cells[c])) + ((b.cells[c] & BLUE_BIT) ? 'B' : 'R');
+    }
+    return state;
+}
+
+// --- Get legal actions for a player, returns how many cells were written to moves ---
+int getLegalActions(const Board& state, char player, int moves[CELLS]) {
+    int n = 0;
+    for (int c = 0; c < CELLS; c++) {
+        if (state.cells[c] == 0 || owned_by(state.cells[c], player)) moves[n++] = c;
+    }
+    return n;
+}
+
+// cells changed by one move with their previous values, enough to take the move back
+struct Undo {
+    int changed;
+    uint8_t cell[CELLS];
+    uint8_t old[CELLS];
+    uint8_t owned[2];
+    uint64_t hash;
+};
+
+// a cell is queued at most once, so the ring buffer never holds more than CELLS entries
+const int RING_SIZE = 64;
+// last resort against endless chains on a board only one player is on
+const int MAX_EXPLOSIONS = 10000;
+
+// statistics of the last make_move, used by the stress test
+thread_local int last_explosions = 0;
+thread_local int last_queue_peak = 0;
+
+// plays move for player on b in place and resolves the explosions with a fixed ring buffer, a cell that
+// is still critical after exploding goes to the back of the queue again; the resolution stops as soon as
+// the opponent, who had cells before the move, has none left since the game is over at that point
+void make_move(Board& b, int move, char player, Undo& undo) {
+    uint64_t saved = 0;
+    undo.changed = 0;
+    undo.owned[0] = b.owned[0];
+    undo.owned[1] = b.owned[1];
+    undo.hash = b.hash;
+    auto set_cell = [&](int c, uint8_t value) {
+        uint8_t before = b.cells[c];
+        if (!(saved >> c & 1)) {
+            saved |= 1ULL << c;
+            undo.cell[undo.changed] = c;
+            undo.old[undo.changed++] = before;
+        }
+        if (before) b.owned[owner_index(before)]--;
+        if (value) b.owned[owner_index(value)]++;
+        b.hash ^= ZOBRIST[c][before] ^ ZOBRIST[c][value];
+        b.cells[c] = value;
+    };
+
+    uint8_t owner = owner_bit(player);
+    int opponent = owner ? 0 : 1;
+    bool opponent_was_on_board = b.owned[opponent] > 0;
+
+    set_cell(move, (orbs(b.cells[move]) + 1) | owner);
+
+    int ring[RING_SIZE];
+    uint64_t queued = 0;
+    int head = 0, tail = 0;
+    auto push = [&](int c) {
+        if (queued >> c & 1) return;
+        queued |= 1ULL << c;
+        ring[tail++ & (RING_SIZE - 1)] = c;
+        last_queue_peak = max(last_queue_peak, tail - head);
+    };
+    last_explosions = 0;
+    last_queue_peak = 0;
+    if (orbs(b.cells[move]) >= CRITICAL[move]) push(move);
+
+    while (head != tail && last_explosions < MAX_EXPLOSIONS) {
+        int c = ring[head++ & (RING_SIZE - 1)];
+        queued &= ~(1ULL << c);
+
+        uint8_t cell = b.cells[c];
+        if (orbs(cell) < CRITICAL[c]) continue;
+        last_explosions++;
+
+        uint8_t exploding = cell & BLUE_BIT;
+        int left = orbs(cell) - CRITICAL[c];
+        set_cell(c, left > 0 ? (left | exploding) : 0);
+        if (left >= CRITICAL[c]) push(c);
+
+        for (int k = 0; k < NEIGHBOR_COUNT[c]; k++) {
+            int n = NEIGHBORS[c][k];
+            int count = orbs(b.cells[n]) + 1;
+            set_cell(n, count | exploding);
+            if (count >= CRITICAL[n]) push(n);
+        }
+
+        if (opponent_was_on_board && b.owned[opponent] == 0) break;
+    }
+}
+
+void unmake_move(Board& b, const Undo& undo) {
+    for (int i = 0; i < undo.changed; i++) b.cells[undo.cell[i]] = undo.old[i];
+    b.owned[0] = undo.owned[0];
+    b.owned[1] = undo.owned[1];
+    b.hash = undo.hash;
+}
+
+// copy of state with the move played
+Board applyAction(const Board& state, int move, char player) {
+    Board b = state;
+    Undo undo;
+    make_move(b, move, player, undo);
+    return b;
+}
+
+char checkWinner(const Board& b) {
+    int red = b.owned[0], blue = b.owned[1];
+    if (red + blue <= 1) return 'N'; // No winner yet (too early)
+    if (red == 0) return 'B';
+    if (blue == 0) return 'R';
+    return 'N';
+}
+
+
+// --- Text board, kept as the reference for the compact one ---
+
 // --- Get legal actions for a player ---
 vector<pair<int, int>> getLegalActions(char player) {
     vector<pair<int, int>> moves;
@@ -174,8 +401,9 @@ char checkWinner(const vector<vector<string>>& board) {
 
 
 
-// --- Heuristic function pointer ---
-int (*heuristic)(const vector<vector<string>>&, char) = nullptr;
+// --- Heuristic function pointer for the text minimax ---
+int (*legacy_heuristic)(const vector<vector<string>>&, char) = nullptr;
+long long legacy_nodes = 0;
 
 
 //
@@ -279,8 +507,9 @@ int heuristic_corner_bonus(const vector<vector<string>>& state, char player) {
 
 // --- Minimax with alpha-beta pruning ---
 pair<int, pair<int, int>> minimax(vector<vector<string>> state, int depth, int alpha, int beta, bool maximizing, char player) {
+    legacy_nodes++;
     if (depth == 0 || checkWinner(state) != 'N') {
-        return {heuristic(state, AI_PLAYER), {-1, -1}};
+        return {legacy_heuristic(state, AI_PLAYER), {-1, -1}};
     }
 
     char currentPlayer = maximizing ? player : getOpponent(player);
@@ -319,6 +548,469 @@ pair<int, pair<int, int>> minimax(vector<vector<string>> state, int depth, int a
 }
 
 
+// --- Heuristics on the compact board, same scores as the text versions above ---
+
+int heuristic_critical_cells(const Board& state, char player) {
+    int score = 0;
+    for (int c = 0; c < CELLS; c++) {
+        if (!owned_by(state.cells[c], player)) continue;
+        int n = orbs(state.cells[c]);
+        if (n == CRITICAL[c] - 1) score += 5;
+        else if (n == CRITICAL[c] - 2) score += 2;
+    }
+    return score;
+}
+
+int heuristic_orb_count(const Board& state, char player) {
+    int score = 0;
+    for (int c = 0; c < CELLS; c++) {
+        if (owned_by(state.cells[c], player)) score += orbs(state.cells[c]);
+    }
+    return score;
+}
+
+int heuristic_controlled_cells(const Board& state, char player) {
+    int score = 0;
+    for (int c = 0; c < CELLS; c++) {
+        if (owned_by(state.cells[c], player)) score++;
+    }
+    return score;
+}
+
+int heuristic_vulnerable_cells(const Board& state, char player) {
+    int penalty = 0;
+    char opponent = getOpponent(player);
+    for (int c = 0; c < CELLS; c++) {
+        if (!owned_by(state.cells[c], player) || orbs(state.cells[c]) < CRITICAL[c] - 1) continue;
+        for (int k = 0; k < NEIGHBOR_COUNT[c]; k++) {
+            if (owned_by(state.cells[NEIGHBORS[c][k]], opponent)) {
+                penalty += 4;
+                break;
+            }
+        }
+    }
+    return -penalty;
+}
+
+int heuristic_corner_bonus(const Board& state, char player) {
+    int score = 0;
+    for (int c : {0, COLS - 1, CELLS - COLS, CELLS - 1}) {
+        if (owned_by(state.cells[c], player)) score += 3;
+    }
+    return score;
+}
+
+// --- Heuristic function pointer for the compact search ---
+int (*heuristic)(const Board&, char) = nullptr;
+
+// the heuristics by name, --heuristic=<name> picks the one the engine plays with
+struct HeuristicChoice {
+    string name;
+    int (*compact)(const Board&, char);
+    int (*text)(const vector<vector<string>>&, char);
+};
+
+const vector<HeuristicChoice> HEURISTICS = {
+    {"critical_cells", heuristic_critical_cells, heuristic_critical_cells},
+    {"orb_count", heuristic_orb_count, heuristic_orb_count},
+    {"controlled_cells", heuristic_controlled_cells, heuristic_controlled_cells},
+    {"vulnerable_cells", heuristic_vulnerable_cells, heuristic_vulnerable_cells},
+    {"corner_bonus", heuristic_corner_bonus, heuristic_corner_bonus},
+};
+
+int find_heuristic(const string& name) {
+    for (int i = 0; i < (int)HEURISTICS.size(); i++) {
+        if (HEURISTICS[i].name == name) return i;
+    }
+    return -1;
+}
+
+// search state is per thread so that lazy smp helpers can run the same minimax, only the transposition
+// table is shared
+thread_local long long nodes_searched = 0;
+
+// --- Transposition table ---
+// fixed size and lock free: every entry holds its data and the key xored with the data, so a reader that
+// sees the halves of two different writes gets a key that does not match and treats the entry as a miss
+const int TT_BITS = 20;
+const int TT_SIZE = 1 << TT_BITS;
+const int BOUND_EXACT = 0, BOUND_LOWER = 1, BOUND_UPPER = 2;
+
+struct TTEntry {
+    atomic<uint64_t> check; // key ^ data
+    atomic<uint64_t> data;  // score in the low 32 bits, then depth, bound and best move + 1 a byte each
+};
+
+struct TTHit {
+    int score, depth, bound, move;
+};
+
+vector<TTEntry> tt(TT_SIZE);
+bool use_tt = true;
+uint64_t tt_salt = 0; // xored into every key, lets searches with different heuristics share the table
+thread_local long long tt_probes = 0, tt_hits = 0, tt_cutoffs = 0;
+
+void tt_clear() {
+    for (auto& e : tt) {
+        e.check.store(0, memory_order_relaxed);
+        e.data.store(0, memory_order_relaxed);
+    }
+}
+
+bool tt_probe(uint64_t key, TTHit& hit) {
+    TTEntry& e = tt[key & (TT_SIZE - 1)];
+    uint64_t data = e.data.load(memory_order_relaxed);
+    if ((e.check.load(memory_order_relaxed) ^ data) != key) return false;
+    hit.score = (int32_t)(uint32_t)data;
+    hit.depth = (data >> 32) & 0xff;
+    hit.bound = (data >> 40) & 0xff;
+    hit.move = (int)((data >> 48) & 0xff) - 1;
+    return true;
+}
+
+// keeps an entry of the same position searched deeper, anything else is replaced
+void tt_store(uint64_t key, int depth, int bound, int score, int move) {
+    TTEntry& e = tt[key & (TT_SIZE - 1)];
+    uint64_t old = e.data.load(memory_order_relaxed);
+    if ((e.check.load(memory_order_relaxed) ^ old) == key && (int)((old >> 32) & 0xff) > depth) return;
+    uint64_t data = (uint32_t)score | (uint64_t)depth << 32 | (uint64_t)bound << 40 | (uint64_t)(move + 1) << 48;
+    e.data.store(data, memory_order_relaxed);
+    e.check.store(key ^ data, memory_order_relaxed);
+}
+
+// --- Time control ---
+// a search past the deadline or told to stop unwinds at once and its result is thrown away, the clock
+// and the stop flag are read every 1024 nodes
+thread_local bool time_limited = false;
+thread_local bool search_aborted = false;
+chrono::steady_clock::time_point search_deadline;
+atomic<bool> stop_search(false);
+thread_local int root_hint = -1; // best move of the previous iteration, searched first at the root
+
+inline bool out_of_time() {
+    if (time_limited && !search_aborted && (nodes_searched & 1023) == 0 &&
+        (stop_search.load(memory_order_relaxed) || chrono::steady_clock::now() >= search_deadline)) {
+        search_aborted = true;
+    }
+    return search_aborted;
+}
+
+// --- Move ordering ---
+// the transposition table move first, then moves that explode (the more opponent neighbours they take the
+// better), then the two killer moves of the ply, then the rest by history score
+const int MAX_SEARCH_DEPTH = 32;
+bool use_ordering = true;
+thread_local int killers[MAX_SEARCH_DEPTH + 1][2];
+thread_local int history_score[2][CELLS];
+
+void clear_ordering() {
+    memset(killers, -1, sizeof(killers));
+    memset(history_score, 0, sizeof(history_score));
+}
+
+// killers are kept per ply, the history per player and cell and halved once it gets large
+void record_cutoff(int move, char player, int depth, int ply) {
+    if (killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+    int* h = history_score[owner_bit(player) ? 1 : 0];
+    h[move] += depth * depth;
+    if (h[move] > (1 << 15)) {
+        for (int c = 0; c < CELLS; c++) h[c] /= 2;
+    }
+}
+
+void order_moves(const Board& state, char player, int moves[CELLS], int count, int ttMove, int ply) {
+    int score[CELLS];
+    for (int i = 0; i < count; i++) {
+        int c = moves[i];
+        if (c == ttMove) score[i] = 1 << 30;
+        else if (orbs(state.cells[c]) + 1 >= CRITICAL[c]) {
+            int captured = 0;
+            for (int k = 0; k < NEIGHBOR_COUNT[c]; k++) {
+                uint8_t n = state.cells[NEIGHBORS[c][k]];
+                if (n && !owned_by(n, player)) captured++;
+            }
+            score[i] = (1 << 20) + (captured << 16);
+        }
+        else if (c == killers[ply][0]) score[i] = (1 << 17) + 1;
+        else if (c == killers[ply][1]) score[i] = 1 << 17;
+        else score[i] = history_score[owner_bit(player) ? 1 : 0][c];
+    }
+    // insertion sort, stable so equal moves keep the row-major order
+    for (int i = 1; i < count; i++) {
+        int m = moves[i], sc = score[i], j = i - 1;
+        while (j >= 0 && score[j] < sc) {
+            moves[j + 1] = moves[j];
+            score[j + 1] = score[j];
+            j--;
+        }
+        moves[j + 1] = m;
+        score[j + 1] = sc;
+    }
+}
+
+// --- Minimax with alpha-beta pruning on the compact board ---
+// the side to move is the AI when maximizing and the human otherwise, the moves are made and taken back
+// on state so the search never copies a board; the transposition table gives cutoffs below the root and
+// the move to try first
+pair<int, int> minimax(Board& state, int depth, int alpha, int beta, bool maximizing, int ply = 0) {
+    nodes_searched++;
+    if (out_of_time()) return {0, -1};
+    if (depth == 0 || checkWinner(state) != 'N') {
+        return {heuristic(state, AI_PLAYER), -1};
+    }
+
+    uint64_t key = state.hash ^ (maximizing ? ZOBRIST_SIDE : 0) ^ tt_salt;
+    int ttMove = -1;
+    if (use_tt) {
+        tt_probes++;
+        TTHit hit;
+        if (tt_probe(key, hit)) {
+            tt_hits++;
+            ttMove = hit.move;
+            // the root always searches so that it has a move to return
+            if (ply > 0 && hit.depth >= depth &&
+                (hit.bound == BOUND_EXACT || (hit.bound == BOUND_LOWER && hit.score >= beta) || (hit.bound == BOUND_UPPER && hit.score <= alpha))) {
+                tt_cutoffs++;
+                return {hit.score, hit.move};
+            }
+        }
+    }
+
+    if (ply == 0 && root_hint != -1) ttMove = root_hint;
+
+    char currentPlayer = maximizing ? AI_PLAYER : HUMAN_PLAYER;
+    int moves[CELLS];
+    int count = getLegalActions(state, currentPlayer, moves);
+    if (use_ordering) {
+        order_moves(state, currentPlayer, moves, count, ttMove, ply);
+    } else {
+        for (int i = 1; i < count && ttMove != -1; i++) {
+            if (moves[i] == ttMove) swap(moves[0], moves[i]);
+        }
+    }
+    int bestMove = -1;
+    int alphaOrig = alpha, betaOrig = beta;
+    int best;
+
+    if (maximizing) {
+        int maxEval = INT_MIN;
+        for (int i = 0; i < count; i++) {
+            Undo undo;
+            make_move(state, moves[i], currentPlayer, undo);
+            int eval = minimax(state, depth - 1, alpha, beta, false, ply + 1).first;
+            unmake_move(state, undo);
+            if (search_aborted) return {0, -1};
+            if (eval > maxEval) {
+                maxEval = eval;
+                bestMove = moves[i];
+            }
+            alpha = max(alpha, eval);
+            if (beta <= alpha) {
+                if (use_ordering) record_cutoff(moves[i], currentPlayer, depth, ply);
+                break;
+            }
+        }
+        best = maxEval;
+    } else {
+        int minEval = INT_MAX;
+        for (int i = 0; i < count; i++) {
+            Undo undo;
+            make_move(state, moves[i], currentPlayer, undo);
+            int eval = minimax(state, depth - 1, alpha, beta, true, ply + 1).first;
+            unmake_move(state, undo);
+            if (search_aborted) return {0, -1};
+            if (eval < minEval) {
+                minEval = eval;
+                bestMove = moves[i];
+            }
+            beta = min(beta, eval);
+            if (beta <= alpha) {
+                if (use_ordering) record_cutoff(moves[i], currentPlayer, depth, ply);
+                break;
+            }
+        }
+        best = minEval;
+    }
+
+    if (use_tt) {
+        int bound = best <= alphaOrig ? BOUND_UPPER : best >= betaOrig ? BOUND_LOWER : BOUND_EXACT;
+        tt_store(key, depth, bound, best, bestMove);
+    }
+    return {best, bestMove};
+}
+
+// --- Iterative deepening ---
+double move_time_ms = 1000; // per move budget, --time=<ms>
+int search_threads = 1;     // --threads=<n>, the main search plus n - 1 lazy smp helpers
+
+struct SearchResult {
+    int score = 0, move = -1, depth = 0;
+    long long nodes = 0;
+    double ms = 0;
+    bool ponder_hit = false;
+};
+
+// lazy smp helper: the same iterative deepening on its own copy of the root, odd helpers one ply ahead,
+// so the threads fill the shared transposition table for each other; runs until the main search stops it
+void helper_search(Board root, int max_depth, int id, long long* nodes) {
+    nodes_searched = 0;
+    search_aborted = false;
+    time_limited = true;
+    root_hint = -1;
+    clear_ordering();
+    for (int depth = 1 + id % 2; depth <= max_depth && !search_aborted; depth++) {
+        int move = minimax(root, depth, INT_MIN, INT_MAX, true).second;
+        if (!search_aborted) root_hint = move;
+    }
+    *nodes = nodes_searched;
+}
+
+// searches depth 1, 2, ... until the budget runs out and returns the last completed iteration, depth 1
+// always completes; a new iteration is not started past half the budget since it would take several
+// times longer than the one before and be thrown away
+SearchResult iterative_deepening(const Board& root, double budget_ms, int max_depth, bool verbose) {
+    auto start = chrono::steady_clock::now();
+    Board state = root;
+    SearchResult result;
+    nodes_searched = 0;
+    search_aborted = false;
+    search_deadline = start + chrono::microseconds((long long)(budget_ms * 1000));
+    root_hint = -1;
+    clear_ordering();
+
+    stop_search = false;
+    vector<thread> helpers;
+    vector<long long> helper_nodes(max(search_threads - 1, 0), 0);
+    for (int id = 1; id < search_threads; id++) {
+        helpers.emplace_back(helper_search, root, max_depth, id, &helper_nodes[id - 1]);
+    }
+
+    for (int depth = 1; depth <= max_depth; depth++) {
+        time_limited = depth > 1;
+        auto [score, move] = minimax(state, depth, INT_MIN, INT_MAX, true);
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (search_aborted) break;
+
+        result.score = score;
+        result.move = move;
+        result.depth = depth;
+        root_hint = move;
+        if (verbose) {
+            cout << "  depth " << depth << ": move " << move << " score " << score << ", " << nodes_searched << " nodes, " << elapsed << " ms" << endl;
+        }
+        if (move == -1 || elapsed >= budget_ms / 2) break;
+    }
+
+    stop_search = true;
+    for (auto& t : helpers) t.join();
+    time_limited = false;
+    root_hint = -1;
+    result.nodes = nodes_searched;
+    for (long long n : helper_nodes) result.nodes += n;
+    result.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+
+
+// --- Pondering ---
+// after its move the engine guesses the human reply from the transposition table and searches the position
+// after that reply in the background; the table stays warm either way and a correct guess hands over the
+// ponder search itself
+bool use_ponder = false; // --ponder
+
+struct Ponder {
+    thread worker;
+    bool active = false;
+    Board position; // predicted position, AI to move
+    chrono::steady_clock::time_point start;
+    mutex lock;
+    SearchResult result; // last completed iteration
+    atomic<bool> done{false};
+} ponder;
+
+long long ponder_started = 0, ponder_hits = 0, ponder_misses = 0, ponder_no_guess = 0;
+
+void ponder_search() {
+    nodes_searched = 0;
+    search_aborted = false;
+    time_limited = true;
+    root_hint = -1;
+    clear_ordering();
+    Board state = ponder.position;
+    for (int depth = 1; depth <= MAX_SEARCH_DEPTH; depth++) {
+        auto [score, move] = minimax(state, depth, INT_MIN, INT_MAX, true);
+        if (search_aborted) break;
+        {
+            lock_guard<mutex> guard(ponder.lock);
+            ponder.result.score = score;
+            ponder.result.move = move;
+            ponder.result.depth = depth;
+            ponder.result.nodes = nodes_searched;
+        }
+        root_hint = move;
+        if (move == -1) break;
+    }
+    ponder.done = true;
+}
+
+void stop_pondering() {
+    if (!ponder.active) return;
+    ponder.active = false;
+    stop_search = true;
+    ponder.worker.join();
+}
+
+// root is the position the AI just searched and move the move it plays
+void start_pondering(const Board& root, int move) {
+    if (!use_ponder || move == -1) return;
+    Board after = applyAction(root, move, AI_PLAYER);
+    if (checkWinner(after) != 'N') return;
+    TTHit hit;
+    if (!tt_probe(after.hash ^ tt_salt, hit) || hit.move == -1) {
+        ponder_no_guess++;
+        return;
+    }
+    ponder.position = applyAction(after, hit.move, HUMAN_PLAYER);
+    if (checkWinner(ponder.position) != 'N') return;
+
+    ponder.result = SearchResult();
+    ponder.done = false;
+    ponder.start = chrono::steady_clock::now();
+    search_deadline = chrono::steady_clock::time_point::max();
+    stop_search = false;
+    ponder.worker = thread(ponder_search);
+    ponder.active = true;
+    ponder_started++;
+}
+
+// the AI move for root; on a ponder hit the ponder search goes on until it has searched for the move budget
+// in total, counting the time it ran while the human was thinking, otherwise it is stopped and the move is
+// searched as usual
+SearchResult search_move(const Board& root) {
+    if (ponder.active) {
+        auto arrived = chrono::steady_clock::now();
+        bool hit = memcmp(root.cells, ponder.position.cells, CELLS) == 0;
+        if (hit) {
+            auto deadline = ponder.start + chrono::microseconds((long long)(move_time_ms * 1000));
+            while (!ponder.done && chrono::steady_clock::now() < deadline) this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        stop_pondering();
+        SearchResult r = ponder.result;
+        if (hit && r.depth > 0) {
+            ponder_hits++;
+            r.ponder_hit = true;
+            r.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - arrived).count();
+            return r;
+        }
+        ponder_misses++;
+    }
+    return iterative_deepening(root, move_time_ms, MAX_SEARCH_DEPTH, false);
+}
+
 // prev apply action function
 vector<vector<string>> PrevApplyAction(const vector<vector<string>>& state, pair<int, int> move, char player) {
     vector<vector<string>> newState = state;
@@ -338,15 +1030,20 @@ vector<vector<string>> PrevApplyAction(const vector<vector<string>>& state, pair
 
 // --- Write AI move to file ---
 void write_ai_move(const string& filename) {
-    int depth_limit = 3;
-    auto [score, move] = minimax(board, depth_limit, INT_MIN, INT_MAX, true, AI_PLAYER);
-    cout << "AI Move: " << move.first << ", " << move.second << " with score: " << score << endl;
+    Board root = to_board(board);
+    SearchResult r = search_move(root);
+    pair<int, int> move = {-1, -1};
+    if (r.move != -1) move = {r.move / COLS, r.move % COLS};
+    cout << "AI Move: " << move.first << ", " << move.second << " with score: " << r.score << " (depth " << r.depth << ", "
+         << r.nodes << " nodes, " << r.ms << " ms" << (r.ponder_hit ? ", ponder hit" : "") << ")" << endl;
 
     if (move.first != -1) {
         board = PrevApplyAction(board, move, AI_PLAYER);
     }
 
-    ofstream fout(filename);
+    // written next to the game state and renamed over it so the GUI never reads half a board
+    string tmp_name = filename + ".tmp";
+    ofstream fout(tmp_name);
     fout << "AI Move:\n";
     for (int i = 0; i < ROWS; ++i) {
         for (int j = 0; j < COLS; ++j) {
@@ -355,15 +1052,752 @@ void write_ai_move(const string& filename) {
         }
         fout << "\n";
     }
+    fout.close();
+    rename(tmp_name.c_str(), filename.c_str());
 
     cout << "AI move written                        .\n";
+    start_pondering(root, r.move);
+}
+
+// --- Benchmark ---
+
+// reads a board written in the gamestate.txt format, whatever the header says
+bool read_board_file(const string& filename, vector<vector<string>>& state) {
+    ifstream fin(filename);
+    if (!fin) return false;
+    string header;
+    getline(fin, header);
+    state.assign(ROWS, vector<string>(COLS, "0"));
+    for (int i = 0; i < ROWS; ++i) {
+        for (int j = 0; j < COLS; ++j) {
+            if (!(fin >> state[i][j])) return false;
+        }
+    }
+    return true;
+}
+
+// gamestate.txt if it is there, the empty board, and positions after random play from a fixed seed
+vector<Board> benchmark_positions() {
+    vector<Board> positions;
+    vector<vector<string>> saved;
+    if (read_board_file("gamestate.txt", saved)) positions.push_back(to_board(saved));
+
+    Board empty = {};
+    refresh_board(empty);
+    positions.push_back(empty);
+    mt19937 gen(318);
+    for (int plies : {8, 16, 24, 32}) {
+        Board b = empty;
+        char player = HUMAN_PLAYER;
+        for (int k = 0; k < plies && checkWinner(b) == 'N'; k++) {
+            int moves[CELLS];
+            int count = getLegalActions(b, player, moves);
+            b = applyAction(b, moves[gen() % count], player);
+            player = getOpponent(player);
+        }
+        positions.push_back(b);
+    }
+    return positions;
+}
+
+// checks the compact board against the text one on every position, then times minimax with both
+void run_bench(int depth) {
+    vector<Board> positions = benchmark_positions();
+
+    int mismatches = 0;
+    for (const Board& b : positions) {
+        vector<vector<string>> text = to_text(b);
+        for (char player : {HUMAN_PLAYER, AI_PLAYER}) {
+            for (auto& h : HEURISTICS) {
+                if (h.compact(b, player) != h.text(text, player)) mismatches++;
+            }
+            board = text; // the text getLegalActions reads the global board
+            vector<pair<int, int>> text_moves = getLegalActions(player);
+            int moves[CELLS];
+            int count = getLegalActions(b, player, moves);
+            if (count != (int)text_moves.size()) mismatches++;
+            for (int i = 0; i < count && i < (int)text_moves.size(); i++) {
+                if (to_text(applyAction(b, moves[i], player)) != applyAction(text, text_moves[i], player)) mismatches++;
+            }
+        }
+    }
+    cout << positions.size() << " positions, " << (mismatches == 0 ? "compact board matches the text board" : to_string(mismatches) + " MISMATCHES") << endl;
+
+    // the text minimax takes its moves from the global board instead of the searched state, so the two
+    // searches walk different trees and only the per node rates compare; the compact one runs as plain
+    // alpha-beta without the table or move ordering
+    cout << "depth " << depth << ": text nodes and nodes/s, compact nodes and nodes/s, nodes/s ratio (different trees)" << endl;
+    use_tt = use_ordering = false;
+    for (int p = 0; p < (int)positions.size(); p++) {
+        vector<vector<string>> text = to_text(positions[p]);
+        board = text;
+        legacy_nodes = 0;
+        auto start = chrono::steady_clock::now();
+        minimax(text, depth, INT_MIN, INT_MAX, true, AI_PLAYER);
+        double text_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        nodes_searched = 0;
+        start = chrono::steady_clock::now();
+        minimax(positions[p], depth, INT_MIN, INT_MAX, true);
+        double compact_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        double text_nps = legacy_nodes / text_seconds, compact_nps = nodes_searched / compact_seconds;
+        cout << "position " << p << ": " << legacy_nodes << " nodes " << (long long)text_nps << " nodes/s, " << nodes_searched << " nodes "
+             << (long long)compact_nps << " nodes/s, nodes/s ratio " << compact_nps / text_nps << endl;
+    }
+}
+
+// searches every benchmark position without and with the transposition table, the scores have to agree
+// since a position is always reached at the same remaining depth within one search
+void run_tt(int max_depth) {
+    vector<Board> positions = benchmark_positions();
+    int mismatches = 0;
+    cout << "position depth: nodes without tt, nodes with tt, reduction, tt hit rate, tt cutoffs, time without / with" << endl;
+    for (int p = 0; p < (int)positions.size(); p++) {
+        for (int depth = 3; depth <= max_depth; depth++) {
+            Board b = positions[p];
+            use_tt = use_ordering = false;
+            nodes_searched = 0;
+            auto start = chrono::steady_clock::now();
+            int plain_score = minimax(b, depth, INT_MIN, INT_MAX, true).first;
+            double plain_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            long long plain_nodes = nodes_searched;
+
+            use_tt = true;
+            tt_clear();
+            nodes_searched = tt_probes = tt_hits = tt_cutoffs = 0;
+            start = chrono::steady_clock::now();
+            int tt_score = minimax(b, depth, INT_MIN, INT_MAX, true).first;
+            double tt_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            if (tt_score != plain_score) mismatches++;
+
+            cout << "position " << p << " depth " << depth << ": " << plain_nodes << ", " << nodes_searched << ", "
+                 << 100.0 * (plain_nodes - nodes_searched) / plain_nodes << "%, " << 100.0 * tt_hits / max(tt_probes, 1LL) << "%, "
+                 << tt_cutoffs << ", " << plain_seconds * 1000 << " ms / " << tt_seconds * 1000 << " ms" << endl;
+        }
+    }
+    cout << (mismatches == 0 ? "Scores agree" : to_string(mismatches) + " score MISMATCHES") << endl;
+}
+
+// iterative deepening on every benchmark position with the given budget
+void run_think(double budget_ms) {
+    vector<Board> positions = benchmark_positions();
+    for (int p = 0; p < (int)positions.size(); p++) {
+        cout << "position " << p << ":" << endl;
+        SearchResult r = iterative_deepening(positions[p], budget_ms, MAX_SEARCH_DEPTH, true);
+        cout << "  reached depth " << r.depth << ", move " << r.move << ", " << r.nodes << " nodes in " << r.ms << " ms ("
+             << (long long)(r.nodes / (r.ms / 1000)) << " nodes/s)" << endl;
+    }
+}
+
+// fixed depth node counts with no ordering, with the transposition table move only and with the full
+// ordering, on the benchmark positions or on the given board files
+void run_order(int depth, const vector<string>& files) {
+    vector<Board> positions;
+    for (const string& f : files) {
+        vector<vector<string>> saved;
+        if (read_board_file(f, saved)) positions.push_back(to_board(saved));
+        else cerr << "Cannot read " << f << endl;
+    }
+    if (files.empty()) positions = benchmark_positions();
+
+    struct Setting { const char* name; bool tt, ordering; };
+    vector<Setting> settings = {{"row-major", false, false}, {"tt move", true, false}, {"tt + ordering", true, true}};
+    vector<long long> total(settings.size(), 0);
+    int mismatches = 0;
+    cout << "depth " << depth << ": nodes (time) for row-major, tt move, tt + ordering" << endl;
+    for (int p = 0; p < (int)positions.size(); p++) {
+        cout << "position " << p << ":";
+        int first_score = 0;
+        for (int k = 0; k < (int)settings.size(); k++) {
+            Board b = positions[p];
+            use_tt = settings[k].tt;
+            use_ordering = settings[k].ordering;
+            tt_clear();
+            clear_ordering();
+            nodes_searched = 0;
+            auto start = chrono::steady_clock::now();
+            int score = minimax(b, depth, INT_MIN, INT_MAX, true).first;
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            if (k == 0) first_score = score;
+            else if (score != first_score) mismatches++;
+            total[k] += nodes_searched;
+            cout << " " << nodes_searched << " (" << ms << " ms)";
+        }
+        cout << endl;
+    }
+    cout << "total:";
+    for (int k = 0; k < (int)settings.size(); k++) cout << " " << settings[k].name << " " << total[k] << (k > 0 ? " (" + to_string(100 * total[k] / max(total[0], 1LL)) + "%)" : "");
+    cout << endl << (mismatches == 0 ? "Scores agree" : to_string(mismatches) + " score MISMATCHES") << endl;
+}
+
+// depth reached and nodes/s of the time limited search on the benchmark positions for 1, 2, 4, ...
+// threads up to max_threads
+void run_smp(double budget_ms, int max_threads) {
+    vector<Board> positions = benchmark_positions();
+    cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        search_threads = threads;
+        double depth_sum = 0, nodes = 0, ms = 0;
+        for (const Board& b : positions) {
+            tt_clear();
+            SearchResult r = iterative_deepening(b, budget_ms, MAX_SEARCH_DEPTH, false);
+            depth_sum += r.depth;
+            nodes += r.nodes;
+            ms += r.ms;
+        }
+        cout << threads << " threads: average depth " << depth_sum / positions.size() << ", " << (long long)(nodes / (ms / 1000)) << " nodes/s" << endl;
+    }
+}
+
+// plays the engine with pondering against a simulated human who thinks for the move budget and then plays
+// the reply that looks best one ply ahead, or a random one 30% of the time
+void run_ponder(int ai_moves) {
+    use_ponder = true;
+    mt19937 gen(49);
+    Board empty = {};
+    refresh_board(empty);
+    Board b = empty;
+    int count_hit = 0, count_other = 0, depth_hit = 0, depth_other = 0;
+    double ms_hit = 0, ms_other = 0;
+    for (int played = 0; played < ai_moves;) {
+        this_thread::sleep_for(chrono::microseconds((long long)(move_time_ms * 1000)));
+        int moves[CELLS];
+        int count = getLegalActions(b, HUMAN_PLAYER, moves);
+        int reply = moves[gen() % count];
+        if (gen() % 10 >= 3) {
+            int best = INT_MAX;
+            for (int i = 0; i < count; i++) {
+                int score = heuristic(applyAction(b, moves[i], HUMAN_PLAYER), AI_PLAYER);
+                if (score < best) {
+                    best = score;
+                    reply = moves[i];
+                }
+            }
+        }
+        b = applyAction(b, reply, HUMAN_PLAYER);
+        if (checkWinner(b) != 'N') {
+            stop_pondering();
+            b = empty;
+            continue;
+        }
+
+        SearchResult r = search_move(b);
+        played++;
+        if (r.ponder_hit) {
+            count_hit++;
+            depth_hit += r.depth;
+            ms_hit += r.ms;
+        } else {
+            count_other++;
+            depth_other += r.depth;
+            ms_other += r.ms;
+        }
+        start_pondering(b, r.move);
+        b = applyAction(b, r.move, AI_PLAYER);
+        if (checkWinner(b) != 'N') {
+            stop_pondering();
+            b = empty;
+        }
+    }
+    stop_pondering();
+    cout << ai_moves << " AI moves, pondered " << ponder_started << ", hits " << ponder_hits << ", misses " << ponder_misses << ", no guess "
+         << ponder_no_guess << " (hit rate " << 100.0 * ponder_hits / max(ponder_started, 1LL) << "%)" << endl;
+    if (count_hit) cout << "on a hit: depth " << (double)depth_hit / count_hit << ", " << ms_hit / count_hit << " ms to answer" << endl;
+    if (count_other) cout << "otherwise: depth " << (double)depth_other / count_other << ", " << ms_other / count_other << " ms to answer" << endl;
+}
+
+// --- Self-play tournament ---
+// two contestants, each a heuristic and a fixed search depth, play each other in forked worker processes
+// that have their own transposition table; the first plies are random so that the games differ
+const int OPENING_PLIES = 4;
+const int MAX_GAME_PLIES = 2000;
+
+struct Contestant {
+    int heuristic; // index in HEURISTICS
+    int depth;
+};
+
+// totals of one worker, index 0 is the first contestant
+struct TournamentTotals {
+    long long wins[2] = {0, 0}, draws = 0, games = 0;
+    long long moves[2] = {0, 0}, nodes[2] = {0, 0};
+    double ms[2] = {0, 0};
+};
+
+bool parse_contestant(const string& spec, Contestant& c) {
+    size_t colon = spec.find(':');
+    if (colon == string::npos) return false;
+    c.heuristic = find_heuristic(spec.substr(0, colon));
+    c.depth = atoi(spec.c_str() + colon + 1);
+    return c.heuristic != -1 && c.depth >= 1 && c.depth <= MAX_SEARCH_DEPTH;
+}
+
+// game g: contestant g % 2 is red and moves first
+void play_game(const Contestant players[2], int g, TournamentTotals& totals) {
+    mt19937 gen(5000 + g);
+    const char colors[2] = {g % 2 == 0 ? 'R' : 'B', g % 2 == 0 ? 'B' : 'R'};
+    // the contestant and the colour it scores for are part of the key, so both contestants can share the
+    // table across games whichever colour they play
+    const uint64_t salts[2] = {0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL};
+    const uint64_t BLUE_SALT = 0x165667b19e3779f9ULL;
+
+    Board b = {};
+    refresh_board(b);
+    int p = g % 2;
+    int ply = 0;
+    for (; ply < MAX_GAME_PLIES && checkWinner(b) == 'N'; ply++, p = 1 - p) {
+        int moves[CELLS];
+        int count = getLegalActions(b, colors[p], moves);
+        int move = moves[gen() % count];
+        if (ply >= OPENING_PLIES) {
+            AI_PLAYER = colors[p];
+            HUMAN_PLAYER = colors[1 - p];
+            heuristic = HEURISTICS[players[p].heuristic].compact;
+            tt_salt = salts[p] ^ (colors[p] == 'B' ? BLUE_SALT : 0);
+            clear_ordering();
+            nodes_searched = 0;
+            auto start = chrono::steady_clock::now();
+            move = minimax(b, players[p].depth, INT_MIN, INT_MAX, true).second;
+            totals.ms[p] += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            totals.nodes[p] += nodes_searched;
+            totals.moves[p]++;
+        }
+        b = applyAction(b, move, colors[p]);
+    }
+
+    char winner = checkWinner(b);
+    if (winner == 'N') totals.draws++;
+    else totals.wins[winner == colors[0] ? 0 : 1]++;
+    totals.games++;
+}
+
+bool write_all(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool read_all(int fd, void* data, size_t size) {
+    char* p = (char*)data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+// a worker only counts if it sent its whole totals and exited cleanly
+void run_tournament(int games, const Contestant players[2], int workers) {
+    cout.flush();
+    vector<int> fds;
+    vector<pid_t> pids;
+    for (int w = 0; w < workers; w++) {
+        int pipe_fd[2];
+        if (pipe(pipe_fd) < 0) {
+            cerr << "Cannot create pipe" << endl;
+            break;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            cerr << "Cannot fork worker" << endl;
+            close(pipe_fd[0]);
+            close(pipe_fd[1]);
+            break;
+        }
+        if (pid == 0) {
+            close(pipe_fd[0]);
+            TournamentTotals totals;
+            for (int g = w; g < games; g += workers) play_game(players, g, totals);
+            bool sent = write_all(pipe_fd[1], &totals, sizeof(totals));
+            close(pipe_fd[1]);
+            _exit(sent ? 0 : 1);
+        }
+        close(pipe_fd[1]);
+        fds.push_back(pipe_fd[0]);
+        pids.push_back(pid);
+    }
+
+    auto start = chrono::steady_clock::now();
+    TournamentTotals sum;
+    int failed = 0;
+    for (int w = 0; w < (int)fds.size(); w++) {
+        TournamentTotals totals;
+        bool received = read_all(fds[w], &totals, sizeof(totals));
+        close(fds[w]);
+        int status = 0;
+        bool exited = waitpid(pids[w], &status, 0) == pids[w] && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!received || !exited) {
+            cerr << "Worker " << w << " failed, its games are left out" << endl;
+            failed++;
+            continue;
+        }
+        sum.draws += totals.draws;
+        sum.games += totals.games;
+        for (int p = 0; p < 2; p++) {
+            sum.wins[p] += totals.wins[p];
+            sum.moves[p] += totals.moves[p];
+            sum.nodes[p] += totals.nodes[p];
+            sum.ms[p] += totals.ms[p];
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // 95% Wilson interval of the score of the first contestant, a draw counts half
+    double n = max(sum.games, 1LL), z = 1.96;
+    double score = (sum.wins[0] + 0.5 * sum.draws) / n;
+    double center = (score + z * z / (2 * n)) / (1 + z * z / n);
+    double half = z * sqrt(score * (1 - score) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+    cout << sum.games << " games with " << fds.size() - failed << " workers in " << seconds << " s" << endl;
+    for (int p = 0; p < 2; p++) {
+        cout << HEURISTICS[players[p].heuristic].name << ":" << players[p].depth << ": " << sum.wins[p] << " wins, "
+             << sum.ms[p] / max(sum.moves[p], 1LL) << " ms per move, " << (long long)(sum.nodes[p] / max(sum.ms[p] / 1000, 1e-9)) << " nodes/s" << endl;
+    }
+    cout << sum.draws << " draws" << endl;
+    cout << "score of " << HEURISTICS[players[0].heuristic].name << ":" << players[0].depth << ": " << 100 * score << "% (95% interval "
+         << 100 * max(0.0, center - half) << "% - " << 100 * min(1.0, center + half) << "%)" << endl;
+}
+
+// --- Stress test of the explosion resolver ---
+
+int total_orbs(const Board& b) {
+    int total = 0;
+    for (int c = 0; c < CELLS; c++) total += orbs(b.cells[c]);
+    return total;
+}
+
+// checks one move made with make_move: owner counts and hash, orb conservation, a stable board unless the game
+// ended or the chain was cut off, and that unmake_move gives back the exact board
+bool check_move(Board& b, int move, char player) {
+    Board before = b;
+    Undo undo;
+    make_move(b, move, player, undo);
+    bool ok = true;
+
+    Board recount = b;
+    refresh_board(recount);
+    ok = ok && recount.owned[0] == b.owned[0] && recount.owned[1] == b.owned[1] && recount.hash == b.hash;
+    bool ended = checkWinner(b) != 'N' || last_explosions >= MAX_EXPLOSIONS;
+    ok = ok && total_orbs(b) == total_orbs(before) + 1;
+    if (!ended) {
+        for (int c = 0; c < CELLS; c++) ok = ok && orbs(b.cells[c]) < CRITICAL[c];
+    }
+
+    Board after = b;
+    unmake_move(b, undo);
+    ok = ok && memcmp(&b, &before, sizeof(Board)) == 0;
+    b = after;
+    return ok;
+}
+
+// a board where every cell holds critical mass - 1 orbs, owner picks the owner of each cell
+Board loaded_board(char (*owner)(int)) {
+    Board b = {};
+    for (int c = 0; c < CELLS; c++) b.cells[c] = (CRITICAL[c] - 1) | owner_bit(owner(c));
+    refresh_board(b);
+    return b;
+}
+
+void run_stress(int games) {
+    int failures = 0;
+
+    // --- constructed long chains ---
+    vector<pair<string, Board>> chains = {
+        {"red board with one blue cell", loaded_board([](int c) { return c == CELLS / 2 ? 'B' : 'R'; })},
+        {"checkerboard", loaded_board([](int c) { return (c / COLS + c % COLS) % 2 ? 'B' : 'R'; })},
+        {"red rows over blue rows", loaded_board([](int c) { return c < CELLS / 2 ? 'R' : 'B'; })},
+        {"red only", loaded_board([](int) { return 'R'; })},
+    };
+    for (auto& [name, start] : chains) {
+        Board b = start;
+        if (!check_move(b, 0, 'R')) failures++;
+        cout << name << ": " << last_explosions << " explosions, queue peak " << last_queue_peak << ", winner " << checkWinner(b)
+             << (last_explosions >= MAX_EXPLOSIONS ? " (cut off)" : "") << endl;
+    }
+
+    // --- random games ---
+    mt19937 gen(43);
+    long long moves_made = 0;
+    int longest_chain = 0, queue_peak = 0;
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < games; g++) {
+        Board b = {};
+        char player = HUMAN_PLAYER;
+        for (int ply = 0; ply < 1000 && checkWinner(b) == 'N'; ply++) {
+            int moves[CELLS];
+            int count = getLegalActions(b, player, moves);
+            if (!check_move(b, moves[gen() % count], player)) failures++;
+            moves_made++;
+            longest_chain = max(longest_chain, last_explosions);
+            queue_peak = max(queue_peak, last_queue_peak);
+            player = getOpponent(player);
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << games << " random games, " << moves_made << " moves checked (" << (long long)(moves_made / seconds) << " moves/s), longest chain "
+         << longest_chain << " explosions, queue peak " << queue_peak << endl;
+    cout << (failures == 0 ? "All checks passed" : to_string(failures) + " checks failed") << endl;
+}
+
+// --- Line protocol ---
+// one request per line on stdin and one reply per line on stdout, the log goes to stderr
+//   ping                      -> pong
+//   stats                     -> ponder <started> <hits> <misses> <no guess>
+//   go <54 cells, row-major>  -> bestmove <row> <col> <score> <depth> <nodes> <ms>, row and col are -1 without a move
+//   quit
+// cells are written as in gamestate.txt, 0 or the orb count followed by R or B
+
+bool valid_cell(const string& val) {
+    if (val == "0") return true;
+    if (val.size() < 2 || val.size() > 4 || (val.back() != 'R' && val.back() != 'B')) return false;
+    for (int k = 0; k + 1 < (int)val.size(); k++) {
+        if (val[k] < '0' || val[k] > '9') return false;
+    }
+    int count = stoi(val.substr(0, val.size() - 1));
+    return count > 0 && count <= COUNT_MASK;
+}
+
+void run_protocol() {
+    string line;
+    while (getline(cin, line)) {
+        istringstream ss(line);
+        string command;
+        ss >> command;
+        if (command == "ping") {
+            cout << "pong" << endl;
+        }
+        else if (command == "go") {
+            vector<vector<string>> state(ROWS, vector<string>(COLS, "0"));
+            bool ok = true;
+            for (int i = 0; i < ROWS && ok; i++) {
+                for (int j = 0; j < COLS && ok; j++) ok = (ss >> state[i][j]) && valid_cell(state[i][j]);
+            }
+            if (!ok) {
+                cout << "error bad board" << endl;
+                continue;
+            }
+            Board root = to_board(state);
+            SearchResult r = search_move(root);
+            int row = r.move == -1 ? -1 : r.move / COLS, col = r.move == -1 ? -1 : r.move % COLS;
+            cout << "bestmove " << row << " " << col << " " << r.score << " " << r.depth << " " << r.nodes << " " << r.ms << endl;
+            cerr << "AI Move: " << row << ", " << col << " with score: " << r.score << " (depth " << r.depth << ", " << r.nodes << " nodes, "
+                 << r.ms << " ms" << (r.ponder_hit ? ", ponder hit" : "") << ")" << endl;
+            start_pondering(root, r.move);
+        }
+        else if (command == "stats") {
+            cout << "ponder " << ponder_started << " " << ponder_hits << " " << ponder_misses << " " << ponder_no_guess << endl;
+        }
+        else if (command == "quit") {
+            break;
+        }
+        else if (!command.empty()) {
+            cout << "error unknown command " << command << endl;
+        }
+    }
+    stop_pondering();
+}
+
+// --- Round-trip latency of the protocol and of the file mode ---
+
+// runs a copy of this engine with args inside dir; its stdin and stdout are connected to the returned
+// streams, or stdout goes to /dev/null when from_engine is null, its log on stderr is dropped
+pid_t spawn_engine(const vector<string>& args, const string& dir, FILE*& to_engine, FILE** from_engine) {
+    int in[2], out[2];
+    if (pipe(in) < 0 || pipe(out) < 0) return -1;
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(in[0], 0);
+        if (from_engine) dup2(out[1], 1);
+        else freopen("/dev/null", "w", stdout);
+        freopen("/dev/null", "w", stderr);
+        close(in[0]);
+        close(in[1]);
+        close(out[0]);
+        close(out[1]);
+        if (chdir(dir.c_str()) < 0) _exit(1);
+        vector<char*> child_argv = {(char*)"2105106_engine"};
+        for (const string& a : args) child_argv.push_back((char*)a.c_str());
+        child_argv.push_back(nullptr);
+        execv("/proc/self/exe", child_argv.data());
+        _exit(1);
+    }
+    close(in[0]);
+    close(out[1]);
+    to_engine = fdopen(in[1], "w");
+    if (from_engine) *from_engine = fdopen(out[0], "r");
+    else close(out[0]);
+    return pid;
+}
+
+string cells_line(const Board& b) {
+    vector<vector<string>> text = to_text(b);
+    string line;
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < COLS; j++) line += " " + text[i][j];
+    }
+    return line;
+}
+
+// round trips of ping and of go through the pipe protocol, then of a move through gamestate.txt with the
+// file mode engine, both engines search with the --time budget
+void run_latency(int rounds) {
+    vector<Board> positions = benchmark_positions();
+    string budget = "--time=" + to_string(move_time_ms);
+    char dir_template[] = "/tmp/engine_latency_XXXXXX";
+    string dir = mkdtemp(dir_template);
+
+    FILE *to_engine, *from_engine;
+    pid_t pid = spawn_engine({"pipe", budget}, dir, to_engine, &from_engine);
+    char reply[256];
+    double ping_ms = 0, go_ms = 0, search_ms = 0;
+    for (int r = 0; r < rounds; r++) {
+        auto start = chrono::steady_clock::now();
+        fprintf(to_engine, "ping\n");
+        fflush(to_engine);
+        if (!fgets(reply, sizeof(reply), from_engine)) break;
+        ping_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        fprintf(to_engine, "go%s\n", cells_line(positions[r % positions.size()]).c_str());
+        fflush(to_engine);
+        if (!fgets(reply, sizeof(reply), from_engine)) break;
+        go_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        istringstream ss(reply);
+        string word;
+        double field = 0;
+        ss >> word;
+        for (int k = 0; k < 6; k++) ss >> field; // the last field is the search time
+        search_ms += field;
+    }
+    fprintf(to_engine, "quit\n");
+    fclose(to_engine);
+    fclose(from_engine);
+    waitpid(pid, nullptr, 0);
+    cout << "pipe: ping " << ping_ms / rounds << " ms, go " << go_ms / rounds << " ms of which search " << search_ms / rounds
+         << " ms, overhead " << (go_ms - search_ms) / rounds << " ms" << endl;
+
+    // every file mode move costs at least the 1 s pause and up to 500 ms of polling, so only a few rounds
+    int file_rounds = min(rounds, 3);
+    string state_file = dir + "/gamestate.txt";
+    pid = spawn_engine({"file", budget}, dir, to_engine, nullptr);
+    double file_ms = 0;
+    for (int r = 0; r < file_rounds; r++) {
+        vector<vector<string>> text = to_text(positions[r % positions.size()]);
+        auto start = chrono::steady_clock::now();
+        {
+            ofstream fout(state_file + ".tmp");
+            fout << "Human Move:\n";
+            for (int i = 0; i < ROWS; i++) {
+                for (int j = 0; j < COLS; j++) fout << text[i][j] << (j < COLS - 1 ? " " : "\n");
+            }
+        }
+        rename((state_file + ".tmp").c_str(), state_file.c_str());
+        string header;
+        while (header != "AI Move:" && chrono::steady_clock::now() - start < chrono::seconds(30)) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+            ifstream fin(state_file);
+            getline(fin, header);
+        }
+        file_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    kill(pid, SIGTERM);
+    fclose(to_engine);
+    waitpid(pid, nullptr, 0);
+    remove(state_file.c_str());
+    rmdir(dir.c_str());
+    cout << "file: move " << file_ms / file_rounds << " ms, overhead about " << (file_ms - search_ms / rounds * file_rounds) / file_rounds << " ms" << endl;
 }
 
 // --- Main loop ---
-int main() {
+int main(int argc, char *argv[]) {
     const string filename = "gamestate.txt";
+    init_tables();
+    clear_ordering();
+    string heuristic_name = "critical_cells";
+
+    // --time=<ms>, --threads=<n>, --ponder and --heuristic=<name> can be given anywhere, the other arguments are positional
+    vector<string> args;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("--time=", 0) == 0) move_time_ms = stod(arg.substr(7));
+        else if (arg.rfind("--threads=", 0) == 0) search_threads = max(1, stoi(arg.substr(10)));
+        else if (arg == "--ponder") use_ponder = true;
+        else if (arg.rfind("--heuristic=", 0) == 0) heuristic_name = arg.substr(12);
+        else args.push_back(arg);
+    }
+
+    int chosen = find_heuristic(heuristic_name);
+    if (chosen == -1) {
+        cerr << "Unknown heuristic " << heuristic_name << ", choose one of:";
+        for (auto& h : HEURISTICS) cerr << " " << h.name;
+        cerr << endl;
+        return 1;
+    }
+    heuristic = HEURISTICS[chosen].compact;
+    legacy_heuristic = HEURISTICS[chosen].text;
+
+    string mode = "file";
+    if (args.size() > 0) mode = args[0];
+    if (mode == "bench") {
+        run_bench(args.size() > 1 ? stoi(args[1]) : 3);
+        return 0;
+    }
+    else if (mode == "tt") {
+        run_tt(args.size() > 1 ? stoi(args[1]) : 6);
+        return 0;
+    }
+    else if (mode == "order") {
+        run_order(args.size() > 1 ? stoi(args[1]) : 5, vector<string>(args.begin() + min<size_t>(args.size(), 2), args.end()));
+        return 0;
+    }
+    else if (mode == "think") {
+        run_think(args.size() > 1 ? stod(args[1]) : move_time_ms);
+        return 0;
+    }
+    else if (mode == "smp") {
+        run_smp(args.size() > 1 ? stod(args[1]) : move_time_ms, args.size() > 2 ? stoi(args[2]) : 8);
+        return 0;
+    }
+    else if (mode == "pipe") {
+        run_protocol();
+        return 0;
+    }
+    else if (mode == "latency") {
+        run_latency(args.size() > 1 ? stoi(args[1]) : 20);
+        return 0;
+    }
+    else if (mode == "ponder") {
+        run_ponder(args.size() > 1 ? stoi(args[1]) : 40);
+        return 0;
+    }
+    else if (mode == "tournament") {
+        Contestant players[2] = {{0, 3}, {1, 3}};
+        if ((args.size() > 2 && !parse_contestant(args[2], players[0])) || (args.size() > 3 && !parse_contestant(args[3], players[1]))) {
+            cerr << "A contestant is <heuristic>:<depth>" << endl;
+            return 1;
+        }
+        int workers = args.size() > 4 ? stoi(args[4]) : max(1u, thread::hardware_concurrency());
+        run_tournament(args.size() > 1 ? stoi(args[1]) : 100, players, max(1, workers));
+        return 0;
+    }
+    else if (mode == "stress") {
+        run_stress(args.size() > 1 ? stoi(args[1]) : 1000);
+        return 0;
+    }
+    else if (mode != "file") {
+        cout << "Invalid mode. Defaulting to file." << endl;
+    }
+
     cout << "C++ AI Engine started. Waiting for Human Move...\n";
-    heuristic = heuristic_critical_cells; // Select the heuristic to use
 
     while (true) {
         if (read_human_move(filename)) {
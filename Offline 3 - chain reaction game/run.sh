@@ -0,0 +1,16 @@
+g++ -O2 -pthread 2105106_engine.cpp -o 2105106_engine
+./2105106_engine --time=1000 --threads=1 --heuristic=critical_cells
+
+
+# file (--time=<ms> per move budget, --threads=<n> search threads, --ponder and --heuristic=<name>, can be added to any mode)
+# heuristics: critical_cells orb_count controlled_cells vulnerable_cells corner_bonus
+# pipe (stdin/stdout line protocol, started by 2105106_chain_reaction.py unless it gets --file)
+# latency <rounds>
+# bench <depth>
+# tt <max depth>
+# order <depth> [board files]
+# think <ms>
+# smp <ms> <max threads>
+# ponder <AI moves>
+# tournament <games> <heuristic:depth> <heuristic:depth> <workers>
+# stress <random games>